@@ -0,0 +1,34 @@
+@vs vs
+
+layout(binding = 0) uniform MeshParams {
+  vec4 u_mvp_x; // First row of the 2D view-projection (xyz)
+  vec4 u_mvp_y; // Second row of the 2D view-projection (xyz)
+  vec4 u_color;
+};
+
+in vec2 a_pos;
+
+out vec4 o_color;
+
+void main() {
+  vec3 pos = vec3(a_pos, 1.0);
+
+  gl_Position = vec4(dot(u_mvp_x.xyz, pos), dot(u_mvp_y.xyz, pos), 0.0, 1.0);
+  o_color     = u_color;
+}
+
+@end
+
+@fs fs
+
+in vec4 o_color;
+
+out vec4 frag_color;
+
+void main() {
+  frag_color = o_color;
+}
+
+@end
+
+@program mesh vs fs
@@ -0,0 +1,54 @@
+@vs vs
+
+layout(binding = 0) uniform ParticleParams {
+  vec4 u_mvp_x;       // First row of the 2D view-projection (xyz)
+  vec4 u_mvp_y;       // Second row of the 2D view-projection (xyz)
+  vec4 u_start_color;
+  vec4 u_end_color;
+  vec4 u_scale;       // Start scale (xy) and end scale (zw)
+};
+
+// Per instance: position (xy), rotation (z), and life percentage (w)
+in vec4 a_instance;
+
+out vec2 o_uv;
+out vec4 o_color;
+
+void main() {
+  // Each instance is a 4-vertex triangle strip. The corner comes from the vertex index.
+  
+  vec2 _corner = vec2(float(gl_VertexID & 1), float((gl_VertexID >> 1) & 1));
+  float _life  = clamp(a_instance.w, 0.0, 1.0);
+
+  vec2 _local = (_corner - vec2(0.5)) * mix(u_scale.xy, u_scale.zw, vec2(_life));
+  float _sin  = sin(a_instance.z);
+  float _cos  = cos(a_instance.z);
+
+  vec3 _world = vec3(a_instance.x + ((_local.x * _cos) - (_local.y * _sin)), 
+                     a_instance.y + ((_local.x * _sin) + (_local.y * _cos)), 
+                     1.0);
+
+  gl_Position = vec4(dot(u_mvp_x.xyz, _world), dot(u_mvp_y.xyz, _world), 0.0, 1.0);
+  o_uv        = _corner;
+  o_color     = mix(u_start_color, u_end_color, vec4(_life));
+}
+
+@end
+
+@fs fs
+
+layout(binding = 0) uniform texture2D particle_texture;
+layout(binding = 0) uniform sampler particle_sampler;
+
+in vec2 o_uv;
+in vec4 o_color;
+
+out vec4 frag_color;
+
+void main() {
+  frag_color = texture(sampler2D(particle_texture, particle_sampler), o_uv) * o_color;
+}
+
+@end
+
+@program particle vs fs
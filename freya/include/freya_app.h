@@ -92,6 +92,14 @@ struct AppDesc {
 
   bool has_vsync = false;
 
+  /// Skip rendering (and presenting) frames where nothing visible 
+  /// has changed, and wait on input instead of spinning when idle.
+  bool skip_static_frames = false;
+
+  /// The maximum amount of time (in seconds) to wait for input 
+  /// when idle, before the next update is forced.
+  f64 idle_timeout = 0.25;
+
   char** args_values = nullptr; 
   i32 args_count     = 0;
 };
@@ -8,11 +8,20 @@
 
 namespace freya { // Start of freya
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Forward declarations
+
+struct ParticleEmitterDesc;
+struct PrefabDesc;
+
+/// Forward declarations
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Assets consts
 
 /// The currently valid version of any `.frpkg` file
-const u8 FRPKG_VALID_VERSION  = 6;
+const u8 FRPKG_VALID_VERSION  = 10;
 
 /// A value to indicate an invalid asset group.
 const i32 ASSET_GROUP_INVALID = -1;
@@ -23,6 +32,14 @@ const i16 ASSET_ID_INVALID    = -1;
 /// The ID of the group associated with the rasset cache.
 const i32 ASSET_CACHE_ID      = 0;
 
+/// The default maximum amount of texture data (in bytes) 
+/// to be uploaded to the GPU in a single frame.
+const sizei ASSET_UPLOAD_BUDGET_BYTES = 8 * 1024 * 1024;
+
+/// The default maximum amount of time (in milliseconds) 
+/// to spend uploading textures to the GPU in a single frame.
+const f32 ASSET_UPLOAD_BUDGET_MS      = 2.0f;
+
 /// Assets consts
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -37,6 +54,8 @@ enum AssetType {
   ASSET_TYPE_FONT,
   ASSET_TYPE_AUDIO_BUFFER,
   ASSET_TYPE_LUA,
+  ASSET_TYPE_PARTICLE_CONFIG,
+  ASSET_TYPE_PREFAB,
 
   ASSET_TYPES_MAX,
 };
@@ -158,17 +177,19 @@ struct AssetGroup {
   
   DynamicArray<Font*> fonts;
   DynamicArray<lua_State*> lua_states;
+  DynamicArray<ParticleEmitterDesc*> particle_configs;
+  DynamicArray<PrefabDesc*> prefabs;
   
   HashMap<String, AssetID> named_ids;
 
   ///
   /// @NOTE/@TEMP:
   ///
-  /// We have 4 watchers here for all the assets that are actually 
+  /// We have 6 watchers here for all the assets that are actually 
   /// read from the disk, as opposed to the assets that are created 
-  /// on the CPU. Currently, the 4 are: textures, fonts, audio buffers, and lua files.
+  /// on the CPU. Currently, the 6 are: textures, fonts, audio buffers, lua files, particle configs, and prefabs.
   ///
-  Array<FileWatcher*, 4> watchers; // on the wall... no? ASOIAF?
+  Array<FileWatcher*, 6> watchers; // on the wall... no? ASOIAF?
 };
 /// AssetGroup 
 ///---------------------------------------------------------------------------------------------------------------------
@@ -186,6 +207,22 @@ FREYA_API void asset_manager_shutdown();
 /// Retrieve a reference to an `AssetGroup` object using the given `group_id`.
 FREYA_API AssetGroup& asset_manager_get_group(const AssetGroupID& group_id);
 
+/// Upload the pending textures of any loaded packages to the GPU, without going 
+/// over the current upload budget. 
+///
+/// @NOTE: This is called once every frame by the engine. At least one texture 
+/// will always be uploaded per call, even if it is larger than the budget.
+FREYA_API void asset_manager_update();
+
+/// Set the per-frame upload budget of the asset manager to `max_bytes` bytes 
+/// and `max_milliseconds` milliseconds, whichever runs out first.
+///
+/// @NOTE: By default, the budget is `ASSET_UPLOAD_BUDGET_BYTES` and `ASSET_UPLOAD_BUDGET_MS`.
+FREYA_API void asset_manager_set_upload_budget(const sizei max_bytes, const f32 max_milliseconds);
+
+/// Retrieve the number of textures still waiting to be uploaded to the GPU.
+FREYA_API const u32 asset_manager_get_pending_uploads();
+
 /// Asset manager functions
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -250,17 +287,37 @@ FREYA_API AssetID asset_group_push_audio_buffer(const AssetGroupID& group_id, co
 /// returning a valid `AssetID` to be used later.
 FREYA_API AssetID asset_group_push_lua_state(const AssetGroupID& group_id, const String& lua_source);
 
+/// Push a new `ParticleEmitterDesc` into `group_id`, copying the given `desc`,
+/// returning a valid `AssetID` to be used later.
+FREYA_API AssetID asset_group_push_particle_config(const AssetGroupID& group_id, const ParticleEmitterDesc& desc);
+
+/// Push a new `PrefabDesc` into `group_id`, copying the given `desc`,
+/// returning a valid `AssetID` to be used later.
+FREYA_API AssetID asset_group_push_prefab(const AssetGroupID& group_id, const PrefabDesc& desc);
+
 /// Load a `FRPKG` file at `frpkg_path` and push all of the assts into the given `group_id`. 
 ///
 /// @NOTE: See `asset_group_create` for more information about internal paths.
+///
+/// @NOTE: Textures are streamed to the GPU over the next few frames (see `asset_manager_update`). 
+/// Until then, their `Texture` handles are still valid, but nothing will be drawn with them.
 FREYA_API bool asset_group_load_package(const AssetGroupID& group_id, const FilePath& frpkg_path);
 
+/// Returns `true` if any textures of `group_id` are still waiting to be uploaded to the GPU.
+FREYA_API const bool asset_group_is_streaming(const AssetGroupID& group_id);
+
 /// Get a valid `AssetID` from `group_id`, using the given `asset_name` to identify the asset. 
 ///
 /// @NOTE: This function will return an invalid `AssetID` if the given `asset_name` does not 
 /// exist in `group_id`. The name of the asset is derived from its file stem (i.e `texture.png` -> `texture`).
 FREYA_API const AssetID& asset_group_get_id(const AssetGroupID& group_id, const String& asset_name);
 
+/// Get the name of the given asset `id`, which is the reverse of `asset_group_get_id`.
+///
+/// @NOTE: This function will return an empty string if `id` was never given a name. 
+/// Since names are searched for linearly, it is best to cache the result.
+FREYA_API String asset_group_get_name(const AssetID& id);
+
 /// Retrieve a `sg_buffer`, using `id`.
 ///
 /// @NOTE: This function will assert if the given `id` is either: 
@@ -309,6 +366,22 @@ FREYA_API const AudioBufferID& asset_group_get_audio_buffer(const AssetID& id);
 ///   3 - or the internal type does not match this asset.
 FREYA_API lua_State* asset_group_get_lua_state(const AssetID& id);
 
+/// Retrieve a `ParticleEmitterDesc`, using `id`.
+///
+/// @NOTE: This function will assert if the given `id` is either: 
+///   1 - is invalid and was never created before, 
+///   2 - the internal group ID is invalid,
+///   3 - or the internal type does not match this asset.
+FREYA_API ParticleEmitterDesc* asset_group_get_particle_config(const AssetID& id);
+
+/// Retrieve a `PrefabDesc`, using `id`.
+///
+/// @NOTE: This function will assert if the given `id` is either: 
+///   1 - is invalid and was never created before, 
+///   2 - the internal group ID is invalid,
+///   3 - or the internal type does not match this asset.
+FREYA_API PrefabDesc* asset_group_get_prefab(const AssetID& id);
+
 /// AssetGroupID functions
 ///---------------------------------------------------------------------------------------------------------------------
 
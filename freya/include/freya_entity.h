@@ -41,6 +41,9 @@ using EntityWorld = entt::registry;
 /// Used to indicate an invalid entity ID.
 const EntityID ENTITY_NULL = entt::null;
 
+/// The currently valid version of any scene file saved with `entity_world_save`.
+const u32 SCENE_VALID_VERSION = 1;
+
 /// Consts
 /// ----------------------------------------------------------------------
 
@@ -61,6 +64,9 @@ using OnTimerRunoutFn = std::function<void(EntityWorld& world, EntityID& entt, v
 /// Called inside UI frames to setup layout, taking in `world`, `entt`, and `user_data`.
 using OnUILayoutFn    = std::function<void(EntityWorld& world, EntityID& entt, void* user_data)>;
 
+/// Called when a recorded command of an `EntityCommandBuffer` is played back on `entt` in `world`.
+using EntityCommandFn = std::function<void(EntityWorld& world, EntityID& entt)>;
+
 /// Callbacks
 /// ----------------------------------------------------------------------
 
@@ -72,6 +78,34 @@ struct TagComponent {
 /// TagComponent
 /// ----------------------------------------------------------------------
 
+/// ----------------------------------------------------------------------
+/// TransformChanged
+
+/// An empty tag given to any entity whose `Transform` was changed 
+/// since the last `entity_world_update`. 
+///
+/// Systems that only care about moving entities (physics sync, audio sources, 
+/// the spatial index, etc.) iterate `view<Transform, TransformChanged>()` 
+/// instead of every `Transform` in the world.
+///
+/// @NOTE: The tags are cleared at the very end of `entity_world_update`. 
+struct TransformChanged {};
+
+/// TransformChanged
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// BodyFellAsleep
+
+/// An empty tag given to any entity whose `DynamicBodyComponent` fell asleep 
+/// since the last `entity_world_update`, to be used with `view<BodyFellAsleep>()`.
+///
+/// @NOTE: Just like `TransformChanged`, the tags are cleared at the very end of `entity_world_update`. 
+struct BodyFellAsleep {};
+
+/// BodyFellAsleep
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// TimerComponent
 struct TimerComponent {
@@ -88,6 +122,29 @@ struct TimerComponent {
 /// TimerComponent
 /// ----------------------------------------------------------------------
 
+/// ----------------------------------------------------------------------
+/// ScheduledTimerComponent
+
+/// A timer driven by the timer wheel of the world (see `entity_world_get_timer_wheel`), 
+/// rather than being ticked every frame like `TimerComponent`. Only the timers 
+/// that actually run out cost anything in `entity_world_update`.
+struct ScheduledTimerComponent {
+  /// The handle of the timer in the timer wheel of the world. 
+  /// 
+  /// @NOTE: One shot timers are set back to `TIMER_WHEEL_HANDLE_INVALID` once they run out.
+  TimerWheelHandle handle     = TIMER_WHEEL_HANDLE_INVALID;
+
+  /// The callback that will be initiated when the timer runs out.
+  OnTimerRunoutFn runout_func = nullptr;
+
+  /// The internal user data that will be passed to `runout_func` 
+  /// upon initiation.
+  void* user_data             = nullptr;
+};
+
+/// ScheduledTimerComponent
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// UILayoutComponent
 struct UILayoutComponent {
@@ -102,6 +159,11 @@ struct UILayoutComponent {
 
 /// ----------------------------------------------------------------------
 /// SpriteComponent
+
+/// @NOTE: The renderer keeps `SpriteComponent` and `Transform` in an owning group 
+/// (`world.group<SpriteComponent, Transform>()`), and `AnimationComponent` in a partial-owning 
+/// one (`world.group<AnimationComponent>(entt::get<Transform>)`). Neither of these pools can be 
+/// sorted on its own (sort the group instead), and no other group can own `Transform`.
 struct SpriteComponent {
   /// The texture that will 
   /// be given to the render command.
@@ -159,6 +221,21 @@ struct DynamicBodyComponent {
   
   OnCollisionFn enter_func = nullptr;
   OnCollisionFn exit_func  = nullptr;
+
+  /// The state of the body at the last two physics steps. 
+  /// The `Transform` of the entity will be interpolated between them.
+
+  Vec2 previous_position = Vec2(0.0f);
+  Vec2 current_position  = Vec2(0.0f);
+
+  f32 previous_rotation = 0.0f; 
+  f32 current_rotation  = 0.0f;
+
+  /// The physics step the current state was taken at.
+  u64 last_step = 0;
+
+  /// Set to `true` once the body has fallen asleep, and back to `false` as soon as it moves again.
+  bool is_asleep = false;
 };
 /// DynamicBodyComponent
 /// ----------------------------------------------------------------------
@@ -177,6 +254,216 @@ struct AnimationComponent {
 /// AnimationComponent
 /// ----------------------------------------------------------------------
 
+/// ----------------------------------------------------------------------
+/// PrefabComponentFlags
+enum PrefabComponentFlags {
+  PREFAB_COMPONENT_TAG       = 1 << 0,
+  PREFAB_COMPONENT_SPRITE    = 1 << 1,
+  PREFAB_COMPONENT_ANIMATION = 1 << 2,
+  PREFAB_COMPONENT_BODY      = 1 << 3,
+};
+/// PrefabComponentFlags
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// PrefabDesc
+struct PrefabDesc {
+  /// The scale and rotation given to the transform of each instance.
+  
+  Vec2 scale   = Vec2(1.0f);
+  f32 rotation = 0.0f;
+
+  /// The tag of each instance. 
+  ///
+  /// @NOTE: An empty tag will not add a `TagComponent`.
+  String tag;
+
+  /// The name of the texture (in the same asset group as the prefab) 
+  /// to give each instance through a `SpriteComponent`.
+  ///
+  /// @NOTE: An empty name will not add a `SpriteComponent`.
+  String texture;
+
+  /// The sprite properties of each instance, mirroring `SpriteComponent`.
+
+  Vec4 color    = Vec4(1.0f);
+  Rect2D source = {};
+  i32 layer     = -1;
+
+  /// If this flag is set to `true`, each instance will be given a physics 
+  /// body of `body_type`, with a single box collider of `collider_extents`.
+  ///
+  /// @NOTE: This is set to `false` by default.
+  bool has_body                 = false;
+  PhysicsBodyType body_type     = PHYSICS_BODY_DYNAMIC;
+
+  /// The properties of the body, mirroring `PhysicsBodyDesc`.
+  
+  f32 gravity_factor  = 1.0f;
+  f32 linear_damping  = 0.0f;
+  bool rotation_fixed = false;
+
+  /// The properties of the box collider of the body.
+
+  ColliderDesc collider = {};
+  Vec2 collider_extents = Vec2(0.0f);
+};
+/// PrefabDesc
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Prefab
+struct Prefab {
+  /// The transform every instance starts with. 
+  ///
+  /// @NOTE: The position is ignored, since each instance gets its own.
+  Transform transform;
+
+  /// The components every instance is given (see `PrefabComponentFlags`).
+  u32 components = 0;
+
+  /// The components that are copied as-is into each 
+  /// instance, with their assets already resolved.
+
+  TagComponent tag;
+  SpriteComponent sprite;
+  AnimationComponent animation;
+
+  /// The body and the box collider created for each instance.
+
+  PhysicsBodyDesc body_desc   = {};
+  ColliderDesc collider_desc  = {};
+  Vec2 collider_extents       = Vec2(0.0f);
+
+  OnCollisionFn enter_func = nullptr;
+  OnCollisionFn exit_func  = nullptr;
+};
+/// Prefab
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// SpatialEntry
+struct SpatialEntry {
+  /// The position of the entity at the last update of the index.
+  Vec2 position;
+
+  /// The key of the cell the entity currently lives in.
+  u64 cell;
+
+  /// The index of the entity in its cell.
+  u32 slot;
+};
+/// SpatialEntry
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// SpatialIndex
+struct SpatialIndex {
+  /// The size of each (square) cell of the index.
+  f32 cell_size = 0.0f;
+
+  /// All the entities living in each occupied cell.
+  HashMap<u64, DynamicArray<EntityID>> cells;
+
+  /// The current entry of each entity in the index.
+  HashMap<EntityID, SpatialEntry> entries;
+
+  /// The range of cells that were ever occupied, used 
+  /// to know when to stop searching outwards.
+  
+  IVec2 min_cell = IVec2(0);
+  IVec2 max_cell = IVec2(0);
+};
+/// SpatialIndex
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// HierarchyComponent
+
+/// Links an entity to its parent and children. 
+///
+/// The `Transform` of a child is always kept in world space (so the renderer, physics, 
+/// and every other system can keep using it as-is), and gets recomputed from `local` 
+/// and the transform of its parent whenever either of them changes.
+///
+/// @NOTE: The scale of most things in the engine is their size, which is why 
+/// only the position and rotation of a parent are passed down to its children.
+struct HierarchyComponent {
+  /// The parent of the entity (or `ENTITY_NULL` if this is a root).
+  EntityID parent       = ENTITY_NULL;
+
+  /// The children of the entity, as a linked list through their siblings.
+  
+  EntityID first_child  = ENTITY_NULL;
+  EntityID next_sibling = ENTITY_NULL; 
+  EntityID prev_sibling = ENTITY_NULL;
+  
+  u32 children_count    = 0;
+
+  /// The distance of the entity from its root (roots are at `0`).
+  u32 depth             = 0;
+
+  /// The transform of the entity relative to its parent.
+  Transform local; 
+
+  /// The cached world matrix of the entity (position and rotation only), 
+  /// handed down to its children. Only recomputed when the entity moves.
+  Mat3 matrix           = Mat3(1.0f);
+
+  /// The last hierarchy pass that updated this entity.
+  u64 last_pass         = 0;
+};
+/// HierarchyComponent
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// EntityCommandType
+enum EntityCommandType {
+  ENTITY_COMMAND_CREATE = 0, 
+  ENTITY_COMMAND_DESTROY,
+  ENTITY_COMMAND_EMPLACE,
+  ENTITY_COMMAND_REMOVE,
+};
+/// EntityCommandType
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// EntityCommand
+struct EntityCommand {
+  EntityCommandType type = ENTITY_COMMAND_CREATE;
+
+  /// The entity the command works on (unused by `ENTITY_COMMAND_CREATE`).
+  EntityID entt          = ENTITY_NULL;
+
+  /// The type of the component (from `entt::type_hash`) 
+  /// used by `ENTITY_COMMAND_EMPLACE` and `ENTITY_COMMAND_REMOVE`.
+  u32 component_id       = 0;
+
+  /// The transform given to new entities by `ENTITY_COMMAND_CREATE`.
+  Transform transform;
+
+  /// The function that does the actual work of `ENTITY_COMMAND_EMPLACE` and `ENTITY_COMMAND_REMOVE`, 
+  /// or the (optional) setup function of the new entity with `ENTITY_COMMAND_CREATE`.
+  EntityCommandFn func   = nullptr;
+};
+/// EntityCommand
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// EntityCommandBuffer
+
+/// Records structural changes (creating, destroying, adding and removing components) 
+/// to be played back later, all at once, instead of touching the world right away. 
+///
+/// Commands can be recorded from any thread. The commands recorded by a single 
+/// thread keep their order, while there is no order between different threads.
+struct EntityCommandBuffer {
+  moodycamel::ConcurrentQueue<EntityCommand> commands;
+};
+
+/// EntityCommandBuffer
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// EntityWorld functions
 
@@ -190,6 +477,50 @@ FREYA_API void entity_world_clear(EntityWorld& world);
 /// @NOTE: This function _MUST_ be called only once per frame. 
 FREYA_API void entity_world_update(EntityWorld& world, const f32 delta_time);
 
+/// Retrieve the timer wheel of `world`, creating it if it does not exist yet. 
+///
+/// @NOTE: The wheel is advanced in `entity_world_update`, where the `ScheduledTimerComponent`s 
+/// that ran out get their callbacks called. Any engine timers can be scheduled here as well, 
+/// as long as their user data is an entity that has a `ScheduledTimerComponent`.
+FREYA_API TimerWheel& entity_world_get_timer_wheel(EntityWorld& world);
+
+/// Bring the world transforms of every entity in a hierarchy in `world` up-to-date. 
+///
+/// Only the entities tagged with `TransformChanged` (and everything below them) are touched. 
+/// Parents are always done before their children, and any children that end up moving 
+/// are tagged with `TransformChanged` as well.
+///
+/// @NOTE: This is already called by `entity_world_update`, right after the command buffer 
+/// is played back. However, it can be called manually to pick up any changes made after the update.
+FREYA_API void entity_world_update_hierarchy(EntityWorld& world);
+
+/// Retrieve the command buffer of `world`, creating it if it does not exist yet.
+///
+/// @NOTE: The buffer is played back in `entity_world_update`, right after the timers, 
+/// which makes it safe to use in any callbacks, view loops, or worker threads. 
+/// However, make sure to call this at least once on the main thread before handing 
+/// the buffer to any other threads, since creating it is _not_ thread-safe.
+FREYA_API EntityCommandBuffer& entity_world_get_command_buffer(EntityWorld& world);
+
+/// Save the entities of `world` into a binary scene file at `path`, returning `true` on success. 
+/// Any textures are saved using their names in `group_id`.
+///
+/// @NOTE: Only the plain data components are saved: `Transform`, `SpriteComponent`, 
+/// `TagComponent`, and `TimerComponent` (without its callback). Each component type 
+/// is written as a single contiguous block.
+FREYA_API bool entity_world_save(EntityWorld& world, const FilePath& path, const AssetGroupID& group_id);
+
+/// Load the scene file at `path` into `world`, resolving any textures by name from `group_id`, 
+/// and placing the new entities in `out_entities`. Returns `true` on success.
+///
+/// @NOTE: The file is memory-mapped and each block of components is inserted into 
+/// its pool in bulk, with a single `EVENT_ENTITIES_ADDED` event for the whole scene. 
+/// Any existing entities in `world` are left untouched.
+FREYA_API bool entity_world_load(EntityWorld& world, 
+                                 const FilePath& path, 
+                                 const AssetGroupID& group_id, 
+                                 DynamicArray<EntityID>& out_entities);
+
 /// EntityWorld functions
 /// ----------------------------------------------------------------------
 
@@ -206,6 +537,60 @@ FREYA_API EntityID entity_create(EntityWorld& world,
 /// Destroy the given `entt` and remove it and its components from `world`.
 FREYA_API void entity_destroy(EntityWorld& world, EntityID& entt);
 
+/// Create `count` new entities in the given `world` all at once, with `position`, 
+/// `scale`, and `rotation` as their transform properties, and place them in `out_entities`.
+///
+/// @NOTE: Only a single `EVENT_ENTITIES_ADDED` event is dispatched for all of the new entities, 
+/// instead of an `EVENT_ENTITY_ADDED` for each.
+FREYA_API void entity_create_many(EntityWorld& world,
+                                  DynamicArray<EntityID>& out_entities,
+                                  const sizei count,
+                                  const Vec2& position = Vec2(0.0f), 
+                                  const Vec2& scale    = Vec2(1.0f), 
+                                  const f32 rotation   = 0.0f);
+
+/// Destroy all of the given `entities` at once and remove them and their components from `world`.
+///
+/// @NOTE: Only a single `EVENT_ENTITIES_DESTROYED` event is dispatched for all of the entities, 
+/// instead of an `EVENT_ENTITY_DESTROYED` for each.
+FREYA_API void entity_destroy_many(EntityWorld& world, const DynamicArray<EntityID>& entities);
+
+/// Mark the `Transform` of the given `entt` as changed, so that it gets 
+/// picked up by the next `entity_world_update`.
+///
+/// @NOTE: Use this if the transform was changed directly (through `entity_get_component`, for example). 
+/// Otherwise, `entity_world_patch_transform` already takes care of it.
+FREYA_API void entity_mark_transform_changed(EntityWorld& world, const EntityID& entt);
+
+/// Change the `Transform` of `entt` by calling `func` with a reference to it, 
+/// and mark it as changed. 
+///
+/// Example: 
+/// ```c++
+/// entity_world_patch_transform(world, entt, [&](Transform& transform) {
+///   transform.position += velocity * delta_time;
+/// });
+/// ```
+template<typename Fn>
+FREYA_API Transform& entity_world_patch_transform(EntityWorld& world, const EntityID& entt, Fn&& func) {
+  entity_mark_transform_changed(world, entt);
+  return world.patch<Transform>(entt, std::forward<Fn>(func));
+}
+
+/// Make `parent` the parent of `entt`, keeping `entt` where it currently is in the world. 
+/// Passing `ENTITY_NULL` as the `parent` will detach `entt` and make it a root again.
+/// Returns `false` if `parent` is `entt` itself or one of its children.
+///
+/// @NOTE: Destroying a parent does _not_ destroy its children. They simply become roots.
+FREYA_API bool entity_set_parent(EntityWorld& world, EntityID& entt, const EntityID& parent);
+
+/// Retrieve the parent of `entt`, or `ENTITY_NULL` if it has none.
+FREYA_API EntityID entity_get_parent(EntityWorld& world, EntityID& entt);
+
+/// Set the transform of `entt` relative to its parent to `local`, 
+/// and mark it as changed, moving it (and its children) at the next update.
+FREYA_API void entity_set_local_transform(EntityWorld& world, EntityID& entt, const Transform& local);
+
 /// Add a generic component `Comp` with `Args` initialization arguments 
 /// to the given `entt` in the respective `world`.
 template<typename Comp, typename... Args>
@@ -280,6 +665,17 @@ FREYA_API TimerComponent& entity_add_timer(EntityWorld& world,
                                            const OnTimerRunoutFn& runout_func, 
                                            void* user_data = nullptr);
 
+/// A helper function to add a scheduled timer component to `entt`, using the given `desc`, 
+/// and the `runout_func` and `user_data`. The timer is placed in the timer wheel of `world`.
+///
+/// @NOTE: If `desc.initial_active` is `false`, the timer is not scheduled at all, and can be 
+/// scheduled later using `timer_wheel_schedule` with the entity as the user data.
+FREYA_API ScheduledTimerComponent& entity_add_scheduled_timer(EntityWorld& world, 
+                                                              EntityID& entt, 
+                                                              const TimerDesc& desc, 
+                                                              const OnTimerRunoutFn& runout_func, 
+                                                              void* user_data = nullptr);
+
 /// A helper function to add a UI layout component to `entt`, with the `layout_func` 
 /// that will be called in UI frames, passing in `user_data`.
 FREYA_API UILayoutComponent& entity_add_ui_layout(EntityWorld& world, 
@@ -375,6 +771,186 @@ FREYA_API bool entity_has_component(const EntityWorld& world, const EntityID& en
 /// EntityID functions
 /// ----------------------------------------------------------------------
 
+/// ----------------------------------------------------------------------
+/// Prefab functions
+
+/// Create a prefab `out_prefab` using the information in `desc`, resolving 
+/// any named assets from the given `group_id`.
+FREYA_API void prefab_create(Prefab& out_prefab, const PrefabDesc& desc, const AssetGroupID& group_id);
+
+/// Create a prefab `out_prefab` using the packaged prefab given in `prefab_id`.
+FREYA_API void prefab_create(Prefab& out_prefab, const AssetID& prefab_id);
+
+/// Fill `out_desc` using the global `prefab` table found in the given `lua` state. 
+/// Any fields missing from the table will keep their values in `out_desc`.
+///
+/// @NOTE: This function will return `false` if no `prefab` table was found. 
+FREYA_API bool prefab_desc_load(PrefabDesc& out_desc, lua_State* lua);
+
+/// Add a sprite to every instance of `prefab`, using the given `texture_id`, 
+/// `color`, `source`, and `layer`, mirroring `entity_add_sprite`.
+FREYA_API void prefab_add_sprite(Prefab& prefab, 
+                                 const AssetID& texture_id, 
+                                 const Vec4& color    = Vec4(1.0f), 
+                                 const Rect2D& source = {}, 
+                                 const i32 layer      = -1);
+
+/// Add an animation to every instance of `prefab`, using the given 
+/// `desc` and `tint`, mirroring `entity_add_animation`.
+FREYA_API void prefab_add_animation(Prefab& prefab, const AnimationDesc& desc, const Vec4& tint = Vec4(1.0f));
+
+/// Add the given `tag` to every instance of `prefab`.
+FREYA_API void prefab_add_tag(Prefab& prefab, const String& tag);
+
+/// Add a physics body to every instance of `prefab`, using the information in `desc`, 
+/// with a single box collider of `extents`, using `collider_desc`. 
+///
+/// @NOTE: Static bodies will be given a `StaticBodyComponent`, while both 
+/// dynamic and kinematic bodies will be given a `DynamicBodyComponent`.
+FREYA_API void prefab_add_body(Prefab& prefab, 
+                               const PhysicsBodyDesc& desc, 
+                               const ColliderDesc& collider_desc, 
+                               const Vec2& extents,
+                               const OnCollisionFn& enter_func = nullptr, 
+                               const OnCollisionFn& exit_func  = nullptr);
+
+/// Spawn `count` instances of `prefab` into `world` all at once, placing each at its 
+/// respective position in `positions`, and placing the new entities in `out_entities`.
+///
+/// @NOTE: The components are copied into the pools of `world` in bulk, with a single 
+/// `EVENT_ENTITIES_ADDED` event for the whole batch. Only the physics bodies 
+/// (if any) need to be created one by one.
+FREYA_API void prefab_instantiate(EntityWorld& world, 
+                                  const Prefab& prefab, 
+                                  const Vec2* positions, 
+                                  const sizei count, 
+                                  DynamicArray<EntityID>& out_entities);
+
+/// Prefab functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Spatial index functions
+
+/// Give `world` a spatial index (a uniform hash grid of `cell_size`), which 
+/// will be kept up-to-date with the `Transform` of every entity in `world`.
+///
+/// @NOTE: The index is updated at the end of `entity_world_update`, where only the entities 
+/// tagged with `TransformChanged` are looked at, and only the ones that changed cells are moved around. 
+/// Destroyed entities are removed from the index right away.
+FREYA_API void spatial_index_create(EntityWorld& world, const f32 cell_size = 128.0f);
+
+/// Remove the spatial index of `world`, if it has any.
+FREYA_API void spatial_index_destroy(EntityWorld& world);
+
+/// Bring the spatial index of `world` up-to-date with the current transforms.
+///
+/// @NOTE: This is already called by `entity_world_update`. However, it can be called 
+/// manually to pick up any changes made after the update (as long as they were marked 
+/// with `entity_mark_transform_changed`).
+FREYA_API void spatial_index_update(EntityWorld& world);
+
+/// Retrieve the spatial index of `world`.
+///
+/// @NOTE: This function will assert if `world` was never given an index using `spatial_index_create`.
+FREYA_API SpatialIndex& spatial_index_get(EntityWorld& world);
+
+/// Place every entity within `radius` of `center` into `out_entities`, without going over `capacity`, 
+/// and return the amount of entities placed.
+FREYA_API sizei spatial_index_query_radius(EntityWorld& world, 
+                                           const Vec2& center, 
+                                           const f32 radius, 
+                                           EntityID* out_entities, 
+                                           const sizei capacity);
+
+/// Place every entity inside of `bounds` into `out_entities`, without going over `capacity`, 
+/// and return the amount of entities placed.
+FREYA_API sizei spatial_index_query_rect(EntityWorld& world, 
+                                         const Rect2D& bounds, 
+                                         EntityID* out_entities, 
+                                         const sizei capacity);
+
+/// Place the (at most) `count` closest entities to `center` into `out_entities`, sorted by 
+/// their distance to `center`, and return the amount of entities placed. Any entities 
+/// further away than `max_distance` are ignored.
+///
+/// @NOTE: `out_entities` must be able to hold at least `count` entities.
+FREYA_API sizei spatial_index_query_nearest(EntityWorld& world, 
+                                            const Vec2& center, 
+                                            const sizei count, 
+                                            EntityID* out_entities, 
+                                            const f32 max_distance = FLT_MAX);
+
+/// Spatial index functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// EntityCommandBuffer functions
+
+/// Record the given `command` into `buffer`.
+FREYA_API void entity_command_buffer_push(EntityCommandBuffer& buffer, EntityCommand&& command);
+
+/// Record the creation of a new entity into `buffer`, with `position`, `scale`, and `rotation` 
+/// as its transform properties. 
+///
+/// @NOTE: The entity does not exist until the buffer is played back, where `init_func` 
+/// (if any) is called with the new entity to add any other components to it.
+FREYA_API void entity_command_buffer_create_entity(EntityCommandBuffer& buffer, 
+                                                   const Vec2& position, 
+                                                   const Vec2& scale                = Vec2(1.0f), 
+                                                   const f32 rotation               = 0.0f, 
+                                                   const EntityCommandFn& init_func = nullptr);
+
+/// Record the destruction of `entt` into `buffer`.
+FREYA_API void entity_command_buffer_destroy_entity(EntityCommandBuffer& buffer, const EntityID& entt);
+
+/// Record adding (or replacing) the component `comp` to `entt` into `buffer`.
+template<typename Comp>
+FREYA_API void entity_command_buffer_emplace(EntityCommandBuffer& buffer, const EntityID& entt, const Comp& comp) {
+  EntityCommand command = {
+    .type         = ENTITY_COMMAND_EMPLACE, 
+    .entt         = entt, 
+    .component_id = ::entt::type_hash<Comp>::value(),
+    .func         = [comp](EntityWorld& world, EntityID& target) {
+      world.emplace_or_replace<Comp>(target, comp);
+    },
+  };
+
+  entity_command_buffer_push(buffer, std::move(command));
+}
+
+/// Record removing the component `Comp` from `entt` into `buffer`.
+template<typename Comp>
+FREYA_API void entity_command_buffer_remove(EntityCommandBuffer& buffer, const EntityID& entt) {
+  EntityCommand command = {
+    .type         = ENTITY_COMMAND_REMOVE, 
+    .entt         = entt, 
+    .component_id = ::entt::type_hash<Comp>::value(),
+    .func         = [](EntityWorld& world, EntityID& target) {
+      world.remove<Comp>(target);
+    },
+  };
+
+  entity_command_buffer_push(buffer, std::move(command));
+}
+
+/// Play back every command recorded so far in `buffer` on `world`, emptying it in the process. 
+///
+/// The commands are not played in the order they were recorded. Instead, they are batched by type:
+///   - All the new entities are created together, with a single `EVENT_ENTITIES_ADDED` event.
+///   - All the component changes are sorted by their component type (and then by entity), 
+///     so each pool is only touched once. Changes to the same component of the same 
+///     entity keep their order.
+///   - All the destroyed entities are destroyed together, with a single `EVENT_ENTITIES_DESTROYED` event.
+///
+/// @NOTE: Any commands on entities that are already gone (or that are destroyed 
+/// in the same playback) are skipped. Commands recorded _during_ the playback 
+/// (by an `init_func`, for example) are left for the next playback.
+FREYA_API void entity_command_buffer_playback(EntityWorld& world, EntityCommandBuffer& buffer);
+
+/// EntityCommandBuffer functions
+/// ----------------------------------------------------------------------
+
 } // End of freya
 
 //////////////////////////////////////////////////////////////////////////
@@ -63,6 +63,9 @@ enum EventType {
   
   EVENT_ENTITY_ADDED, 
   EVENT_ENTITY_DESTROYED,
+  
+  EVENT_ENTITIES_ADDED, 
+  EVENT_ENTITIES_DESTROYED,
 
   EVENTS_MAX,
 };
@@ -138,6 +141,15 @@ struct Event {
   /// The entity given to this event by 
   /// either `EVENT_ENTITY_ADDED` or `EVENT_ENTITY_DESTROYED`.
   EntityID entt;
+
+  /// The entities given to this event by 
+  /// either `EVENT_ENTITIES_ADDED` or `EVENT_ENTITIES_DESTROYED`.
+  ///
+  /// @NOTE: The entities are only valid for the duration of the callback.
+  const EntityID* entities;
+
+  /// The amount of entities in `entities`.
+  sizei entities_count;
 };
 /// Event
 ///---------------------------------------------------------------------------------------------------------------------
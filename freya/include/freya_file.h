@@ -68,6 +68,21 @@ using File = std::fstream;
 /// File
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// FileMapping
+struct FileMapping {
+  /// The read-only contents of the mapped file.
+  const u8* data = nullptr;
+
+  /// The size (in bytes) of `data`.
+  sizei size     = 0;
+
+  /// The platform-specific handle of the mapping.
+  void* handle   = nullptr;
+};
+/// FileMapping
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// FileTimePoint
 using FileTimePoint = std::filesystem::file_time_type;
@@ -308,6 +323,16 @@ FREYA_API void file_read_bytes(File& file, String* str);
 /// @NOTE: This function will raise an error if `file` is not opened.
 FREYA_API void file_read_string(File& file, String* str);
 
+/// Map the whole file at `path` into memory as read-only, filling `out_mapping`, 
+/// and returning `true` on success and `false` otherwise.
+///
+/// @NOTE: On platforms without memory mapping (i.e the web), the file 
+/// is simply read into memory instead. Either way, `file_unmap` must be called when done.
+FREYA_API bool file_map(FileMapping& out_mapping, const FilePath& path);
+
+/// Unmap (or free) the memory previously mapped by `file_map` in `mapping`.
+FREYA_API void file_unmap(FileMapping& mapping);
+
 /// File functions
 ///---------------------------------------------------------------------------------------------------------------------
 
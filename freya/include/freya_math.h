@@ -162,6 +162,19 @@ struct Rect2D {
 /// Rect2D
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Rng
+
+/// A small, fast random number generator (xoshiro256++).
+///
+/// @NOTE: An `Rng` is not thread-safe, but it is cheap enough to have one per thread (or per task). 
+/// Two generators given the same seed will always produce the exact same numbers.
+struct Rng {
+  u64 state[4] = {};
+};
+/// Rng
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// PoissonDiskDesc
 struct PoissonDiskDesc {
@@ -187,6 +200,12 @@ struct PoissonDiskDesc {
   ///
   /// @NOTE: The default value is `Vec2(32.0f, 32.0f)`.
   Vec2 region_size = Vec2(32.0f);
+
+  /// The seed used to generate the points. The same seed 
+  /// (with the same desc) will always produce the same points.
+  ///
+  /// @NOTE: The default value is `0`, which uses the default `Rng` of the calling thread instead.
+  u64 seed = 0;
 };
 /// PoissonDiskDesc
 ///---------------------------------------------------------------------------------------------------------------------
@@ -256,6 +275,56 @@ FREYA_API const f32 remap(const f32 value, const f32 old_min, const f32 old_max,
 
 ///---------------------------------------------------------------------------------------------------------------------
 /// Math random functions
+///
+/// @NOTE: The functions without an `Rng` use the default generator of the calling 
+/// thread. Each thread gets its own, so they are safe to call from any thread.
+
+/// Seed the given `rng` with `seed`.
+FREYA_API void rng_seed(Rng& rng, const u64 seed);
+
+/// Retrieve the default generator of the calling thread.
+FREYA_API Rng& rng_get_default();
+
+/// Seed the default generator of the calling thread with `seed`. 
+/// Useful to replay the exact same sequence of random numbers.
+FREYA_API void random_seed(const u64 seed);
+
+/// Returns the next random 64-bit unsigned int value of `rng`
+FREYA_API const u64 random_u64(Rng& rng);
+
+/// Returns a random 64-bit unsigned int value of `rng` between `min` and `max`
+FREYA_API const u64 random_u64(Rng& rng, const u64 min, const u64 max);
+
+/// Returns a random 32-bit unsigned int value of `rng`
+FREYA_API const u32 random_u32(Rng& rng);
+
+/// Returns a random 32-bit unsigned int value of `rng` between `min` and `max`
+FREYA_API const u32 random_u32(Rng& rng, const u32 min, const u32 max);
+
+/// Returns a random 32-bit signed int value of `rng` between `min` and `max`
+FREYA_API const i32 random_i32(Rng& rng, const i32 min, const i32 max);
+
+/// Returns a random 32-bit float value of `rng` between `0.0f` and `1.0f`
+FREYA_API const f32 random_f32(Rng& rng);
+
+/// Returns a random 32-bit float value of `rng` between `min` and `max`
+FREYA_API const f32 random_f32(Rng& rng, const f32 min, const f32 max);
+
+/// Returns a random 64-bit float value of `rng` between `0.0` and `1.0`
+FREYA_API const f64 random_f64(Rng& rng);
+
+/// Fill `out` with `count` random 32-bit float values of `rng` between `min` and `max`
+FREYA_API void random_fill_f32(Rng& rng, f32* out, const sizei count, const f32 min, const f32 max);
+
+/// Returns a random point of `rng` on the edge of the unit circle
+FREYA_API const Vec2 random_on_circle(Rng& rng);
+
+/// Returns a random point of `rng` inside a disc of the given `radius`, 
+/// evenly distributed over the whole area
+FREYA_API const Vec2 random_in_disc(Rng& rng, const f32 radius);
+
+/// Fill `out` with `count` random points of `rng` inside a disc of the given `radius`
+FREYA_API void random_fill_disc(Rng& rng, Vec2* out, const sizei count, const f32 radius);
 
 /// Returns a random 32-bit float value
 FREYA_API const f32 random_f32();
@@ -5,6 +5,8 @@
 
 #include <thread>
 #include <mutex>
+#include <atomic>
+#include <semaphore>
 
 #include <array>
 #include <vector>
@@ -20,6 +22,7 @@
 #include <functional>
 #include <memory>
 #include <chrono>
+#include <cfloat>
 
 #if !defined(__EMSCRIPTEN__)
   #include <filewatch/FileWatch.hpp>
@@ -20,6 +20,9 @@ const f32 PHYSICS_PIXELS_TO_METERS     = 0.02f;
 /// The maximum amount of colliders a body could have.
 const sizei PHYSICS_BODY_COLLIDERS_MAX = 12;
 
+/// The maximum amount of points a `ColliderProxy` could have.
+const sizei COLLIDER_PROXY_POINTS_MAX  = 8;
+
 /// Consts
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -247,6 +250,51 @@ struct CastResult {
 /// CastResult
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// ColliderProxy
+
+/// A flattened, world-space copy of a collider's shape. 
+///
+/// Every collider type boils down to a convex hull of `points`, rounded by `radius`:
+///   - Circles have 1 point. 
+///   - Capsules and segments have 2 points. 
+///   - Polygons have 3 or more points, in counter-clockwise order.
+struct ColliderProxy {
+  Vec2 points[COLLIDER_PROXY_POINTS_MAX];
+  i32 points_count = 0;
+  
+  f32 radius = 0.0f;
+};
+/// ColliderProxy
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// PhysicsBodyMoveEvent
+
+/// Generated for every body that moved during a physics step. 
+/// Resting (sleeping) bodies do not generate any events.
+struct PhysicsBodyMoveEvent {
+  /// The body that moved.
+  PhysicsBodyID body;
+
+  /// The internal user data of `body`.
+  uintptr user_data = 0;
+
+  /// The new position and rotation (in radians) of `body`.
+
+  Vec2 position = Vec2(0.0f);
+  f32 rotation  = 0.0f;
+
+  /// The physics step this event was generated at.
+  u64 step = 0;
+
+  /// Set to `true` if `body` fell asleep during this step. 
+  /// No more events will be generated for it until it wakes up again.
+  bool fell_asleep = false;
+};
+/// PhysicsBodyMoveEvent
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// ExplosionDesc
 struct ExplosionDesc {
@@ -403,6 +451,9 @@ FREYA_API void physics_world_shutdown();
 
 /// Step through the physics simulation every frame, using the given `sub_steps`.
 ///
+/// The world is always stepped at a fixed rate (see `physics_world_set_step_rate`), 
+/// so this might take zero or more steps depending on the frame's delta time.
+///
 /// The `sub_steps` parametar determines the number of iterations to go through a "physics step", 
 /// which consists of collision detection followed by numerical integration.
 /// The higher the value, the more accurate the physics is, but the more performance will suffer.
@@ -423,6 +474,12 @@ FREYA_API bool physics_world_cast_ray_closest(const RayCastDesc& cast_desc, Cast
 /// calling `hit_func` upon any successful intersections.
 FREYA_API void physics_world_cast_collider(const ColliderCastDesc& cast_desc, const OnCastHitFn& hit_func);
 
+/// Query the colliders of every static body that overlaps `bounds` (in world space), 
+/// appending a flattened copy of each one into `out_proxies`.
+///
+/// @NOTE: The proxies are copies. They will not follow the colliders if they ever move.
+FREYA_API void physics_world_query_static_colliders(const Rect2D& bounds, DynamicArray<ColliderProxy>& out_proxies);
+
 /// Add an explosion defined by the given `desc`, firing collision
 /// events if the explosion affects any bodies in the simulation.
 FREYA_API void physics_world_add_explosion(const ExplosionDesc& desc);
@@ -436,6 +493,13 @@ FREYA_API void physics_world_set_gravity(const Vec2& gravity);
 /// By default, it is set to `1.0f`.
 FREYA_API void physics_world_set_fixed_timestep(f32 timestep);
 
+/// Set the amount of fixed steps the physics world takes every second to `rate`. 
+/// Lower rates are cheaper, and the rendered bodies are interpolated 
+/// between steps to hide the difference with the display rate.
+///
+/// @NOTE: By default, it is set to `60.0f`.
+FREYA_API void physics_world_set_step_rate(const f32 rate);
+
 /// Set the debug color of the colliders when drawn.
 ///
 /// @NOTE: By default, the color is set to `Vec4(1.0f, 0.0f, 1.0f, 0.3f)`.
@@ -447,6 +511,22 @@ FREYA_API Vec2 physics_world_get_gravity();
 /// Retrieve the current set fixed timestep of the physics engine.
 FREYA_API f32 physics_world_get_fixed_timestep();
 
+/// Retrieve the amount of fixed steps the physics world takes every second.
+FREYA_API f32 physics_world_get_step_rate();
+
+/// Retrieve how far (between `0.0f` and `1.0f`) the current frame is between 
+/// the last physics step and the next one. 
+FREYA_API f32 physics_world_get_interpolation_alpha();
+
+/// Retrieve the total amount of fixed steps the physics world has taken so far.
+FREYA_API u64 physics_world_get_steps_count();
+
+/// Retrieve the move events of every body that moved in any of the steps 
+/// taken by the last `physics_world_step`, in the order they were taken.
+///
+/// @NOTE: The events are only valid until the next `physics_world_step`.
+FREYA_API const DynamicArray<PhysicsBodyMoveEvent>& physics_world_get_move_events();
+
 /// Retrieve the current debug color of the physics world.
 FREYA_API Vec4 physics_world_get_debug_color();
 
@@ -464,11 +544,12 @@ FREYA_API const bool physics_world_is_paused();
 /// Retrieve the current debug state of the physics world.
 FREYA_API const bool physics_world_is_debug();
 
-/// Initiate draw calls generated by the physics world. 
+/// Initiate draw calls generated by the physics world, skipping any 
+/// shapes that lie outside of `view_bounds` (in pixels). 
 ///
 /// @NOTE: This function does not need to be called by the client. 
 /// It is used internally by the renderer if the physics world is currently in debug mode.
-FREYA_API void physics_world_draw_debug();
+FREYA_API void physics_world_draw_debug(const Rect2D& view_bounds);
 
 /// Physics world functions
 ///---------------------------------------------------------------------------------------------------------------------
@@ -12,12 +12,12 @@ namespace freya { // Start of freya
 /// The maximum amount of zoom the camera can achieve.
 const f32 CAMERA_MAX_ZOOM    = 180.0f;
 
-/// The maximum amount of particles tha can be emitted per emitter.
-const u32 PARTICLES_MAX      = 1024;
-
 /// The maximum amount of render targets a post-process pass can have. 
 const u32 RENDER_TARGETS_MAX = 8; 
 
+/// The maximum amount of frames kept in the renderer's statistics history.
+const u32 RENDERER_STATS_HISTORY_MAX = 240;
+
 /// Consts
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -31,6 +31,34 @@ enum ParticleDistributionType {
 /// ParticleDistributionType
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// ParticleCollisionType
+enum ParticleCollisionType {
+  /// The particles do not collide with anything (other than the emitter's bounds).
+  PARTICLE_COLLISION_NONE = 0, 
+  
+  /// The particles collide with the colliders of any static body in the physics world.
+  PARTICLE_COLLISION_PHYSICS,
+  
+  /// The particles collide with the solid cells of a `ParticleCollisionGrid`.
+  PARTICLE_COLLISION_GRID,
+};
+/// ParticleCollisionType
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// MeshPrimitiveType
+enum MeshPrimitiveType {
+  MESH_PRIMITIVE_TRIANGLES = 0, 
+  MESH_PRIMITIVE_TRIANGLES_STRIP,
+  MESH_PRIMITIVE_LINES,
+  MESH_PRIMITIVE_LINES_STRIP,
+
+  MESH_PRIMITIVES_MAX,
+};
+/// MeshPrimitiveType
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Function signatures
 
@@ -136,17 +164,73 @@ struct Camera {
 /// Camera 
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Mesh2DDesc
+struct Mesh2DDesc {
+  /// The local-space vertices of the mesh. 
+  DynamicArray<Vec2> vertices;
+
+  /// How the `vertices` will be assembled when rendered.
+  ///
+  /// @NOTE: The default value is `MESH_PRIMITIVE_TRIANGLES_STRIP`.
+  MeshPrimitiveType primitive = MESH_PRIMITIVE_TRIANGLES_STRIP;
+
+  /// The group that will own the GPU buffer of the mesh.
+  ///
+  /// @NOTE: The default value is `ASSET_CACHE_ID`.
+  AssetGroupID group_id = ASSET_CACHE_ID;
+};
+/// Mesh2DDesc
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Mesh2D
+struct Mesh2D {
+  AssetID buffer_id = {};
+  sg_buffer buffer  = {};
+
+  u32 vertices_count          = 0;
+  MeshPrimitiveType primitive = MESH_PRIMITIVE_TRIANGLES_STRIP;
+
+  Rect2D bounds = {}; // In local space
+};
+/// Mesh2D
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// ParticleCollisionGrid
+struct ParticleCollisionGrid {
+  /// The top-left corner of the grid in world space.
+  Vec2 position     = Vec2(0.0f);
+
+  /// The size of each cell in the grid.
+  Vec2 cell_size    = Vec2(1.0f);
+
+  /// The amount of cells on each axis.
+  IVec2 cells_count = IVec2(0);
+
+  /// The cells of the grid, row by row. Any non-zero cell is solid.
+  DynamicArray<u8> cells;
+};
+/// ParticleCollisionGrid
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// ParticleEmitterDesc
 struct ParticleEmitterDesc {
   /// The velocity of each particle that will be applied 
   /// in the update loop. 
-  Vec2 velocity;
+  ///
+  /// @NOTE: The default velocity is set to `Vec2(0.0f, 0.0f)`.
+  Vec2 velocity                         = Vec2(0.0f);
 
   /// The amount of particles to emit. 
   ///
-  /// @NOTE: This variable CANNOT exceed `PARTICLES_CPU_MAX`.
-  i32 count; 
+  /// @NOTE: There is no upper limit. The emitter will reserve 
+  /// exactly this many particles in the shared particle pool.
+  ///
+  /// @NOTE: By default, this is set to `0`.
+  i32 count                             = 0; 
 
   /// The unit scale of each particle in the system. 
   ///
@@ -170,12 +254,42 @@ struct ParticleEmitterDesc {
   /// @NOTE: The default values is `Vec4(1.0f, 1.0f, 1.0f, 1.0f)`.
   Vec4 color                            = Vec4(1.0f);
 
+  /// The color/tint multiplier of each particle by the end of its life. 
+  /// The color of each particle is blended from `color` to `color * color_over_life` as it ages. 
+  ///
+  /// @NOTE: The default value is `Vec4(1.0f)`, which keeps the color the same. 
+  Vec4 color_over_life                  = Vec4(1.0f);
+
+  /// The scale multiplier of each particle by the end of its life. 
+  /// The scale of each particle is blended from `scale` to `scale * scale_over_life` as it ages. 
+  ///
+  /// @NOTE: The default value is `Vec2(1.0f)`, which keeps the scale the same. 
+  Vec2 scale_over_life                  = Vec2(1.0f);
+
+  /// If this is set to `true`, each particle will be rotated towards the direction it is moving in.
+  ///
+  /// @NOTE: This is set to `false` by default.
+  bool align_to_velocity                = false;
+
   /// The maximum amount of time a particle can 
-  /// live for after being activated.
+  /// live for after being spawned.
   ///
   /// @NOTE: The default lifetime is set to `2.5f`.
   f32 lifetime                          = 2.5f;
 
+  /// A random amount of time (between `-lifetime_variance` and `lifetime_variance`) 
+  /// added to the lifetime of each particle when spawned.
+  ///
+  /// @NOTE: The default lifetime variance is set to `0.0f`.
+  f32 lifetime_variance                 = 0.0f;
+
+  /// The amount of particles spawned every second while emitting. 
+  /// A spawn rate of `0.0f` makes the emitter spawn all of its 
+  /// particles at once as a single burst on every `particle_emitter_emit`.
+  ///
+  /// @NOTE: The default spawn rate is set to `0.0f`.
+  f32 spawn_rate                        = 0.0f;
+
   /// The gravity contributor of each particle in the system.
   ///
   /// @NOTE: The default gravity is set to `240.0f`.
@@ -196,6 +310,33 @@ struct ParticleEmitterDesc {
   ///
   /// @NOTE: The default distribution radius is set to `1.0f`.
   f32 distribution_radius               = 1.0f;
+
+  /// The seed of the random streams used when spawning particles. 
+  /// Two emitters with the same seed (and the same updates) will 
+  /// always spawn the exact same particles.
+  ///
+  /// @NOTE: The default seed is set to `0`, which picks a random seed instead.
+  u64 seed                              = 0;
+
+  /// What the particles will collide with, if anything.
+  ///
+  /// @NOTE: The default collision is set to `PARTICLE_COLLISION_NONE`.
+  ParticleCollisionType collision       = PARTICLE_COLLISION_NONE;
+
+  /// The grid to collide with when `collision` is set to `PARTICLE_COLLISION_GRID`.
+  ///
+  /// @NOTE: The grid is not copied. It must outlive the emitter.
+  const ParticleCollisionGrid* collision_grid = nullptr;
+
+  /// The amount of velocity (along the normal) a particle keeps after a collision. 
+  ///
+  /// @NOTE: The default bounce is set to `0.5f`.
+  f32 bounce                            = 0.5f;
+
+  /// The amount of velocity (along the surface) a particle loses after a collision. 
+  ///
+  /// @NOTE: The default friction is set to `0.2f`.
+  f32 friction                          = 0.2f;
 };
 /// ParticleEmitterDesc
 ///---------------------------------------------------------------------------------------------------------------------
@@ -207,27 +348,115 @@ struct ParticleEmitter {
   Vec2 initial_velocity = Vec2(0.0f);
   Vec2 bounds           = Vec2(0.0f);
 
-  Transform transforms[PARTICLES_MAX];
-  Vec2 forces[PARTICLES_MAX];
-  Vec2 velocities[PARTICLES_MAX];
+  // @NOTE: The particles themselves live in a shared pool. The emitter 
+  // only refers to a range in it. Use `particle_emitter_get_streams` to access them.
+
+  i32 pool_range         = -1;
+  i32 particles_capacity = 0;
 
   Vec2 position = Vec2(0.0f);
 
+  // @NOTE: The live particles are always packed into `[0, particles_count)`.
+
   i32 particles_count = 0;
-  Timer lifetime; 
+
+  f32 lifetime          = 0.0f;
+  f32 lifetime_variance = 0.0f;
+
+  f32 spawn_rate        = 0.0f;
+  f32 spawn_accumulator = 0.0f;
+
+  u64 seed        = 0;
+  u64 steps_count = 0;
 
   Texture texture; 
   Vec4 color;
+
+  Vec4 color_over_life        = Vec4(1.0f);
+  Vec2 scale_over_life        = Vec2(1.0f);
+  bool is_aligned_to_velocity = false;
   
   f32 distribution_radius               = 1.0f;
   ParticleDistributionType distribution = DISTRIBUTION_RANDOM;
 
   f32 gravity_factor = 0.0f; 
-  bool is_active     = false;
+
+  ParticleCollisionType collision             = PARTICLE_COLLISION_NONE;
+  const ParticleCollisionGrid* collision_grid = nullptr;
+  
+  f32 bounce   = 0.0f; 
+  f32 friction = 0.0f;
+  
+  bool is_emitting = false;
+  bool is_active   = false;
 };
 /// ParticleEmitter 
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// ParticleStreams 
+struct ParticleStreams {
+  f32* positions_x; 
+  f32* positions_y;
+  
+  f32* velocities_x; 
+  f32* velocities_y;
+
+  f32* forces_x; 
+  f32* forces_y;
+
+  f32* ages; 
+  f32* lifetimes;
+
+  i32 count;
+};
+/// ParticleStreams 
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// RendererStats
+struct RendererStats {
+  /// The amount of primitives queued into the painter this frame, 
+  /// before they get merged into batches.
+  u32 painter_commands = 0;
+
+  /// The amount of vertices queued into the painter this frame.
+  u32 painter_vertices = 0;
+
+  /// The amount of sprites (including animations) that were 
+  /// submitted and the amount that were culled out of the camera's view.
+  u32 sprites_submitted = 0; 
+  u32 sprites_culled    = 0;
+
+  /// The amount of particles that were submitted and 
+  /// the amount that were culled out of the camera's view.
+  u32 particles_submitted = 0; 
+  u32 particles_culled    = 0;
+
+  /// The amount of texts that were submitted and 
+  /// the amount that were culled out of the screen.
+  u32 texts_submitted = 0; 
+  u32 texts_culled    = 0;
+
+  /// The amount of post-process passes ran this frame, 
+  /// including the default pass.
+  u32 post_process_passes = 0;
+
+  /// The GPU-side numbers reported by the graphics backend for the frame.
+  u32 draw_calls        = 0;
+  u32 pipeline_switches = 0;
+  u32 bindings_applied  = 0;
+  u32 uniforms_applied  = 0;
+  u32 uploaded_bytes    = 0;
+
+  /// The CPU time (in milliseconds) spent in `renderer_prepare` 
+  /// and `renderer_commit` respectively.
+  f32 prepare_time = 0.0f; 
+  f32 commit_time  = 0.0f;
+};
+/// RendererStats
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// PostProcess functions
 
@@ -291,24 +520,78 @@ FREYA_API Vec2 camera_screen_to_world_space(const Camera& cam, const Vec2& posit
 /// Camera functions
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Mesh2D functions
+
+/// Create a static mesh `out_mesh` using the information in `desc`. 
+///
+/// @NOTE: The vertices are uploaded once into an immutable buffer owned 
+/// by `desc.group_id`, and they cannot be changed afterwards.
+FREYA_API void mesh2d_create(Mesh2D& out_mesh, const Mesh2DDesc& desc);
+
+/// Mesh2D functions
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// ParticleEmitter functions
 
 /// Create a particle emitter `out_emitter` using the information in `desc`.
 FREYA_API void particle_emitter_create(ParticleEmitter& out_emitter, const ParticleEmitterDesc& desc);
 
-/// Create a particle emitter `out_emitter` using the config file given in `config_id`.
+/// Create a particle emitter `out_emitter` using the config given in `config_id`.
+///
+/// @NOTE: The config can either be a packaged particle config (`ASSET_TYPE_PARTICLE_CONFIG`), 
+/// which is simply copied, or a raw LUA state (`ASSET_TYPE_LUA`), which gets evaluated on the spot.
 FREYA_API void particle_emitter_create(ParticleEmitter& out_emitter, const AssetID& config_id);
 
+/// Fill `out_desc` using the global `particle` table found in the given `lua` state. 
+/// Any fields missing from the table will keep their values in `out_desc`.
+///
+/// @NOTE: This function will return `false` if no `particle` table was found. 
+/// Grids and textures cannot be given through the config, so they are never touched.
+FREYA_API bool particle_emitter_desc_load(ParticleEmitterDesc& out_desc, lua_State* lua);
+
 /// A physics update of each particle in the given `emitter` using the scale of `delta_time`. 
+/// Any new particles will be spawned, and any particles that outlived their lifetime will be recycled.
 FREYA_API void particle_emitter_update(ParticleEmitter& emitter, const f32 delta_time); 
 
+/// Update all of the given `emitters` at once using the scale of `delta_time`. 
+///
+/// @NOTE: The emitters are simulated in parallel, with big emitters being split into chunks. 
+/// The results are the exact same as calling `particle_emitter_update` on each emitter.
+FREYA_API void particle_emitters_update(const DynamicArray<ParticleEmitter*>& emitters, const f32 delta_time); 
+
 /// Emit the particles of `emitter` at `position`.
+///
+/// @NOTE: Emitters with no spawn rate will reset and spawn all of their particles at once. 
+/// Otherwise, the emitter will (keep) spawning particles at `position` until `particle_emitter_stop` is called.
 FREYA_API void particle_emitter_emit(ParticleEmitter& emitter, const Vec2& position);
 
+/// Stop spawning any new particles from `emitter`, letting the live ones die out on their own.
+FREYA_API void particle_emitter_stop(ParticleEmitter& emitter);
+
 /// Reset the given `emitter` to its initial state.
 FREYA_API void particle_emitter_reset(ParticleEmitter& emitter);
 
+/// Release the particles of `emitter` back into the shared particle pool.
+FREYA_API void particle_emitter_destroy(ParticleEmitter& emitter);
+
+/// Retrieve the particle streams of the given `emitter` from the shared particle pool. 
+///
+/// @NOTE: The returned pointers are only valid until the next time an 
+/// emitter is created or destroyed, since the pool might grow or get compacted.
+FREYA_API ParticleStreams particle_emitter_get_streams(const ParticleEmitter& emitter);
+
+/// Move all of the live particles in the shared particle pool next to each other, 
+/// releasing any memory left behind by destroyed emitters. 
+///
+/// @NOTE: The pool already compacts itself once enough memory is wasted, 
+/// but this can be called at a convenient time (like between levels) as well.
+FREYA_API void particle_pool_compact();
+
+/// Stop the particle worker threads and free the shared particle pool.
+FREYA_API void particle_pool_shutdown();
+
 /// ParticleEmitter functions
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -349,6 +632,26 @@ FREYA_API void renderer_set_clear_color(const Color& color);
 /// Set whether the renderer should sort the renderable items or not.
 FREYA_API void renderer_set_sort(bool sort);
 
+/// Set whether the renderer can skip frames where nothing visible has changed.
+///
+/// @NOTE: This is `false` by default, and it is usually set through `AppDesc::skip_static_frames`.
+///
+/// @NOTE: Changes are picked up through `TransformChanged` tags and the signals of the
+/// render components. Any component changed in place (without `EntityWorld::patch`)
+/// will only show up once `renderer_request_redraw` is called.
+FREYA_API void renderer_set_skip_static_frames(const bool skip);
+
+/// Force the next frame to be rendered, even if nothing visible seems to have changed. 
+///
+/// @NOTE: This is only needed for changes the renderer cannot see on its own, 
+/// like the uniforms of a post-process pass.
+FREYA_API void renderer_request_redraw();
+
+/// Returns `true` if the next frame has to be rendered. 
+///
+/// @NOTE: This will always return `true` unless skipping static frames is enabled.
+FREYA_API const bool renderer_needs_redraw();
+
 /// Retrieve the renderer's current clear color.
 FREYA_API const Color& renderer_get_clear_color();
 
@@ -358,9 +661,19 @@ FREYA_API u32 renderer_get_post_process_count();
 /// Retrieve a default platform-specific swapchain to give to any passes
 FREYA_API sg_swapchain renderer_get_default_swapchain();
 
+/// Retrieve the world-space rect the current camera can see, as of the last `renderer_prepare`.
+FREYA_API const Rect2D& renderer_get_view_rect();
+
 /// Retrieve the `AssetGroupID` the renderer is currently using.
 FREYA_API AssetGroupID& renderer_get_asset_group_id();
 
+/// Retrieve the statistics of the last fully rendered frame.
+FREYA_API const RendererStats& renderer_get_stats();
+
+/// Retrieve the ring buffer of the last `RENDERER_STATS_HISTORY_MAX` frames' statistics, 
+/// with `out_offset` set to the index of the oldest frame in the buffer.
+FREYA_API const RendererStats* renderer_get_stats_history(u32* out_offset);
+
 /// Queue a texture to be drawn by the end of the frame, using
 /// the given `texture` at `src` and render into `dest`, rotated by `rotation`, tinted with `tint`.
 ///
@@ -389,17 +702,33 @@ FREYA_API void renderer_queue_point(const Vec2& position, f32 size, const Color&
 /// Queue a three-point triangle with points `p1`, `p2`, and `p3` with a `color`.
 FREYA_API void renderer_queue_triangle(const Vec2& p1, const Vec2& p2, const Vec2& p3, const Color& color);
 
+/// Queue a list of triangles, with every three consecutive `vertices` forming one triangle, 
+/// tinted with `color`.
+///
+/// @NOTE: The whole list will be batched into a single draw command.
+FREYA_API void renderer_queue_triangles(const Vec2* vertices, const sizei vertices_count, const Color& color);
+
 /// Queue an array of triangle strips with `vertices` at `transform` tinted with `color`.
 FREYA_API void renderer_queue_triangles_strip(const Transform& transform, 
                                               const DynamicArray<Vec2>& vertices, 
                                               const Color& color);
 
+/// Queue the given static `mesh` at `transform` tinted with `color`.
+///
+/// @NOTE: Any primitives queued before the mesh will be flushed first to keep the draw order. 
+/// It is best used for big static geometry, rather than many small meshes.
+///
+/// @NOTE: Meshes whose bounds end up out of the camera's view are skipped entirely.
+FREYA_API void renderer_queue_mesh(const Mesh2D& mesh, const Transform& transform, const Color& color);
+
 /// Queue an animation using the given `animation`, transformed with `transform` with a `tint`.
 ///
 /// @NOTE: By default, `tint` is set to `Color(1.0f)`.
 FREYA_API void renderer_queue_animation(const Animation& anim, const Transform& transform, const Color& tint = Color(1.0f));
 
 /// Queue particles using the given `emitter`.
+///
+/// @NOTE: Each emitter is drawn as a single instanced draw call, outside of the painter.
 FREYA_API void renderer_queue_particles(const ParticleEmitter& emitter);
 
 /// Queue a text using the given `text`
@@ -22,10 +22,18 @@ using ThreadTaskFn = std::function<void()>;
 /// ThreadPool 
 struct ThreadPool {
   String name; 
-  bool is_active;
+  std::atomic<bool> is_active{false};
 
   DynamicArray<std::thread*> workers; 
   moodycamel::ConcurrentQueue<ThreadTaskFn> tasks;
+
+  // @NOTE: Released once for every pushed task, so idle workers 
+  // can sleep on it instead of spinning on an empty queue.
+  std::counting_semaphore<> tasks_signal{0};
+
+  // @NOTE: Counts the tasks that were pushed but are not done yet, 
+  // including the ones currently being worked on.
+  std::atomic<sizei> pending_tasks{0};
 };
 /// ThreadPool 
 /// ----------------------------------------------------------------------
@@ -43,6 +51,12 @@ FREYA_API void thread_pool_destroy(ThreadPool& pool);
 /// Push the given `task` job to the `pool`'s tasks.
 FREYA_API void thread_pool_push_task(ThreadPool& pool, const ThreadTaskFn& task);
 
+/// Block until every task pushed to `pool` so far is done. 
+///
+/// @NOTE: The calling thread does not just sit there. It will 
+/// help the workers by taking on any tasks still in the queue.
+FREYA_API void thread_pool_wait(ThreadPool& pool);
+
 /// Retrieve the approximate amount of tasks left.
 FREYA_API const sizei thread_pool_get_approx_size(const ThreadPool& pool);
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "freya_entity.h"
+#include "freya_render.h"
 
 //////////////////////////////////////////////////////////////////////////
 
@@ -109,6 +110,12 @@ FREYA_API EntityID& tilemap_place_at(TileMap& map, const sizei x_cell, const siz
 /// Create and place a new tile entity at `position` world coordinates in `layer` index.
 FREYA_API EntityID& tilemap_place_at(TileMap& map, const Vec2& position, const sizei layer = 0);
 
+/// Fill `out_grid` with the tiles of `map` in `layer` index, where every placed tile is solid. 
+/// Useful for particles that need to collide with the map.
+///
+/// @NOTE: The grid is a snapshot. It needs to be built again if the tiles ever change.
+FREYA_API void tilemap_build_collision_grid(TileMap& map, ParticleCollisionGrid& out_grid, const sizei layer = 0);
+
 /// TileMap functions
 /// ----------------------------------------------------------------------
 
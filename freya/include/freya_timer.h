@@ -105,6 +105,128 @@ FREYA_API void timer_reset(Timer& timer);
 /// Timer functions
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Consts
+
+/// The amount of levels in a `TimerWheel`. Each level 
+/// covers `TIMER_WHEEL_SLOTS` times the range of the one below it.
+const u32 TIMER_WHEEL_LEVELS = 4;
+
+/// The amount of slots (buckets) in each level of a `TimerWheel`.
+const u32 TIMER_WHEEL_SLOTS  = 64;
+
+/// An invalid `TimerWheelHandle` that no timer will ever have.
+const u64 TIMER_WHEEL_HANDLE_INVALID = 0;
+
+/// Consts
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// TimerWheelHandle
+
+/// A handle to a timer scheduled in a `TimerWheel`. 
+/// Stays valid until the timer expires (if it's a one shot) or gets cancelled.
+using TimerWheelHandle = u64;
+
+/// TimerWheelHandle
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// TimerWheelEntry
+struct TimerWheelEntry {
+  /// The tick this timer will expire at.
+  u64 deadline  = 0;
+
+  /// The amount of ticks between each expiry (`0` for one shot timers).
+  u64 interval  = 0;
+
+  /// Given back when the timer expires.
+  u64 user_data = 0;
+
+  /// Bumped every time the entry gets recycled, to invalidate old handles.
+  u32 generation = 1;
+  
+  bool is_scheduled = false;
+};
+/// TimerWheelEntry
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// TimerWheelSlot
+struct TimerWheelSlot {
+  /// The indices of the entries in this slot, along with their generation at the time they were placed.
+  /// Cancelled entries are left behind and skipped once the slot is reached.
+  
+  DynamicArray<u32> entries; 
+  DynamicArray<u32> generations;
+};
+/// TimerWheelSlot
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// TimerWheel 
+
+/// A hierarchical timing wheel. 
+///
+/// Time is split into fixed ticks of `resolution` seconds. Timers that expire within the 
+/// next `TIMER_WHEEL_SLOTS` ticks live in the first level, one slot per tick. Timers further 
+/// away live in the higher levels, where each slot covers a whole rotation of the level below, 
+/// and get moved down (cascaded) as their time comes closer. 
+///
+/// Each tick only ever touches the slot that expires on it, which means the cost 
+/// of an update depends on the amount of expiring timers, not the amount of scheduled ones.
+struct TimerWheel {
+  /// The length of a single tick (in seconds).
+  f32 resolution  = 1.0f / 60.0f;
+  f64 accumulator = 0.0;
+  
+  /// The amount of ticks passed since the wheel was created.
+  u64 current_tick = 0;
+  
+  DynamicArray<TimerWheelEntry> entries; 
+  DynamicArray<u32> free_entries;
+
+  TimerWheelSlot slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+};
+/// TimerWheel 
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// TimerWheel functions
+
+/// Initialize `out_wheel` with ticks of `resolution` seconds. 
+///
+/// @NOTE: Timers can never expire in the middle of a tick, so the resolution 
+/// determines how accurate the timers are. By default, it is set to a single frame at 60 FPS.
+FREYA_API void timer_wheel_create(TimerWheel& out_wheel, const f32 resolution = 1.0f / 60.0f);
+
+/// Cancel every timer in `wheel` and reclaim its memory.
+FREYA_API void timer_wheel_clear(TimerWheel& wheel);
+
+/// Schedule a new timer in `wheel` that will expire after `delay` seconds, returning back its handle. 
+/// The given `user_data` will be handed back when the timer expires. 
+///
+/// @NOTE: If `repeat` is set to `true`, the timer will be rescheduled 
+/// every `delay` seconds after it expires, until it gets cancelled.
+FREYA_API TimerWheelHandle timer_wheel_schedule(TimerWheel& wheel, const f32 delay, const u64 user_data, const bool repeat = false);
+
+/// Cancel the timer `handle` in `wheel`, if it's still scheduled.
+FREYA_API void timer_wheel_cancel(TimerWheel& wheel, const TimerWheelHandle handle);
+
+/// Advance `wheel` by `delta_time` seconds, appending the `user_data` of every 
+/// timer that expired into `out_expired`, in the order they expired in.
+FREYA_API void timer_wheel_update(TimerWheel& wheel, const f32 delta_time, DynamicArray<u64>& out_expired);
+
+/// Returns `true` if the timer `handle` is still scheduled in `wheel`.
+FREYA_API bool timer_wheel_is_scheduled(const TimerWheel& wheel, const TimerWheelHandle handle);
+
+/// Retrieve the time left (in seconds) until the timer `handle` in `wheel` expires, 
+/// or `0.0f` if the timer is not scheduled.
+FREYA_API f32 timer_wheel_get_remaining(const TimerWheel& wheel, const TimerWheelHandle handle);
+
+/// TimerWheel functions
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Clock functions
 
@@ -87,6 +87,12 @@ FREYA_API void window_close(Window* window);
 /// Poll events from the `window` context.
 FREYA_API void window_poll_events(Window* window);
 
+/// Block until an event arrives at the `window` context, or until 
+/// `timeout` seconds pass, whichever comes first.
+///
+/// @NOTE: On the web, this will just poll the events without blocking.
+FREYA_API void window_wait_events(Window* window, const f64 timeout);
+
 /// Swap the internal buffer of the `window` context every `interval` count. 
 /// 
 /// @NOTE: The `interval` parametar can be set as `0` if VSYNC is not needed.
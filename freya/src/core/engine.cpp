@@ -15,6 +15,9 @@ struct Engine {
   Window* window;
 
   bool is_running;
+
+  bool is_idle      = false;
+  bool has_rendered = false;
 };
 
 static Engine s_engine;
@@ -59,8 +62,18 @@ static void start_shutdown() {
 }
 
 static void update_and_render() {
-  // Poll for input events
-  window_poll_events(s_engine.window);
+  // Poll for input events. If nothing changed last frame, 
+  // there's no need to spin, so just wait for new events instead.
+
+  if(s_engine.is_idle) {
+    window_wait_events(s_engine.window, s_engine.app_desc.idle_timeout);
+  }
+  else {
+    window_poll_events(s_engine.window);
+  }
+
+  // Stream in any pending assets
+  asset_manager_update();
 
   // Physics world update
   physics_world_step();
@@ -68,13 +81,21 @@ static void update_and_render() {
   // Update
   CHECK_VALID_CALLBACK(s_engine.app_desc.update_fn, clock_get_delta_time());
 
-  // Render 
+  // Skip the whole frame if nothing visible has changed 
+  // (The GUI is immediate, so it always needs a redraw)
 
-  renderer_prepare();
-  renderer_commit();
+  s_engine.has_rendered = renderer_needs_redraw() || gui_is_active();
+  s_engine.is_idle      = s_engine.app_desc.skip_static_frames && !s_engine.has_rendered;
 
-  // Render GUI
-  CHECK_VALID_CALLBACK(s_engine.app_desc.gui_fn);
+  if(s_engine.has_rendered) {
+    // Render 
+
+    renderer_prepare();
+    renderer_commit();
+
+    // Render GUI
+    CHECK_VALID_CALLBACK(s_engine.app_desc.gui_fn);
+  }
 
   // Update the internal systems
 
@@ -101,8 +122,11 @@ static bool desktop_update_and_render() {
   // Main loop
   update_and_render();
 
-  // Present
-  window_swap_buffers(s_engine.window, s_engine.app_desc.has_vsync);
+  // Present (only if there's something new to present)
+
+  if(s_engine.has_rendered) {
+    window_swap_buffers(s_engine.window, s_engine.app_desc.has_vsync);
+  }
 
   // Done!
   
@@ -170,6 +194,7 @@ i32 engine_run(const AppDesc& desc) {
 
   // Renderer init 
   renderer_init(s_engine.window);
+  renderer_set_skip_static_frames(desc.skip_static_frames);
 
   // Audio init
   audio_device_init(nullptr);
@@ -1,10 +1,153 @@
 #include "freya_timer.h"
 #include "freya_memory.h"
+#include "freya_logger.h"
 
 //////////////////////////////////////////////////////////////////////////
 
 namespace freya { // Start of freya
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Consts
+
+const u32 TIMER_WHEEL_SLOT_BITS = 6; 
+const u64 TIMER_WHEEL_SLOT_MASK = TIMER_WHEEL_SLOTS - 1;
+
+static_assert((1u << TIMER_WHEEL_SLOT_BITS) == TIMER_WHEEL_SLOTS, "TIMER_WHEEL_SLOT_BITS must match TIMER_WHEEL_SLOTS");
+
+/// Consts
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Private functions
+
+static inline TimerWheelHandle make_handle(const u32 index, const u32 generation) {
+  return ((u64)generation << 32) | (u64)index;
+}
+
+static TimerWheelEntry* get_entry(const TimerWheel& wheel, const TimerWheelHandle handle) {
+  u32 index      = (u32)(handle & 0xffffffff);
+  u32 generation = (u32)(handle >> 32);
+
+  if(index >= wheel.entries.size()) {
+    return nullptr;
+  }
+
+  const TimerWheelEntry& entry = wheel.entries[index];
+  if(!entry.is_scheduled || entry.generation != generation) {
+    return nullptr;
+  }
+
+  return (TimerWheelEntry*)&entry;
+}
+
+static void free_entry(TimerWheel& wheel, const u32 index) {
+  TimerWheelEntry& entry = wheel.entries[index];
+  entry.is_scheduled     = false;
+
+  // Any old handles (or slots) still pointing to this entry are now invalid.
+  // Zero is skipped, since it could make an invalid handle.
+
+  entry.generation++;
+  if(entry.generation == 0) {
+    entry.generation = 1;
+  }
+
+  wheel.free_entries.push_back(index);
+}
+
+static void place_entry(TimerWheel& wheel, const u32 index) {
+  const TimerWheelEntry& entry = wheel.entries[index];
+
+  u64 deadline = entry.deadline;
+  u64 delta    = deadline - wheel.current_tick;
+
+  // Find the lowest level that can still reach the deadline
+
+  u32 level = 0;
+  while(level < (TIMER_WHEEL_LEVELS - 1) && delta >= (1ull << (TIMER_WHEEL_SLOT_BITS * (level + 1)))) {
+    level++;
+  }
+
+  // Anything beyond the range of the whole wheel gets parked in the furthest 
+  // slot, and will be placed again (with its real deadline) once it's reached.
+
+  u64 max_range = 1ull << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS);
+  if(delta >= max_range) {
+    deadline = wheel.current_tick + (max_range - 1);
+  }
+
+  u64 slot_index       = (deadline >> (TIMER_WHEEL_SLOT_BITS * level)) & TIMER_WHEEL_SLOT_MASK;
+  TimerWheelSlot& slot = wheel.slots[level][slot_index];
+
+  slot.entries.push_back(index);
+  slot.generations.push_back(entry.generation);
+}
+
+static void take_slot(TimerWheel& wheel, const u32 level, TimerWheelSlot& out_slot) {
+  u64 slot_index       = (wheel.current_tick >> (TIMER_WHEEL_SLOT_BITS * level)) & TIMER_WHEEL_SLOT_MASK;
+  TimerWheelSlot& slot = wheel.slots[level][slot_index];
+
+  // Swapping keeps the memory of both slots around for the next time
+
+  out_slot.entries.clear();
+  out_slot.generations.clear();
+
+  std::swap(out_slot.entries, slot.entries);
+  std::swap(out_slot.generations, slot.generations);
+}
+
+static void tick_wheel(TimerWheel& wheel, TimerWheelSlot& scratch, DynamicArray<u64>& out_expired) {
+  wheel.current_tick++;
+
+  // Every time a level finishes a whole rotation, the next slot 
+  // of the level above it gets moved down closer to the front.
+
+  for(u32 level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+    u64 level_mask = (1ull << (TIMER_WHEEL_SLOT_BITS * level)) - 1;
+    if((wheel.current_tick & level_mask) != 0) {
+      break;
+    }
+
+    take_slot(wheel, level, scratch);
+
+    for(sizei i = 0; i < scratch.entries.size(); i++) {
+      u32 index = scratch.entries[i];
+
+      if(wheel.entries[index].is_scheduled && wheel.entries[index].generation == scratch.generations[i]) {
+        place_entry(wheel, index);
+      }
+    }
+  }
+
+  // Expire everything in the current slot of the first level
+
+  take_slot(wheel, 0, scratch);
+
+  for(sizei i = 0; i < scratch.entries.size(); i++) {
+    u32 index              = scratch.entries[i];
+    TimerWheelEntry& entry = wheel.entries[index];
+
+    if(!entry.is_scheduled || entry.generation != scratch.generations[i]) { // Cancelled
+      continue;
+    }
+
+    out_expired.push_back(entry.user_data);
+
+    // Repeating timers go right back in
+
+    if(entry.interval > 0) {
+      entry.deadline += entry.interval;
+      place_entry(wheel, index);
+    }
+    else {
+      free_entry(wheel, index);
+    }
+  }
+}
+
+/// Private functions
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// PerfTimer functions
 
@@ -77,6 +220,102 @@ void timer_reset(Timer& timer) {
 /// Timer functions
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// TimerWheel functions
+
+void timer_wheel_create(TimerWheel& out_wheel, const f32 resolution) {
+  FREYA_DEBUG_ASSERT((resolution > 0.0f), "Cannot create a timer wheel with a resolution of 0");
+
+  timer_wheel_clear(out_wheel);
+
+  out_wheel.resolution   = resolution;
+  out_wheel.accumulator  = 0.0;
+  out_wheel.current_tick = 0;
+}
+
+void timer_wheel_clear(TimerWheel& wheel) {
+  wheel.entries.clear();
+  wheel.free_entries.clear();
+
+  for(auto& level : wheel.slots) {
+    for(auto& slot : level) {
+      slot.entries.clear();
+      slot.generations.clear();
+    }
+  }
+}
+
+TimerWheelHandle timer_wheel_schedule(TimerWheel& wheel, const f32 delay, const u64 user_data, const bool repeat) {
+  // Get a free entry (or make a new one)
+
+  u32 index = 0; 
+  if(!wheel.free_entries.empty()) {
+    index = wheel.free_entries.back();
+    wheel.free_entries.pop_back();
+  }
+  else {
+    index = (u32)wheel.entries.size();
+    wheel.entries.emplace_back();
+  }
+
+  // Timers take at least a single tick, since the current one is already underway
+
+  u64 ticks = (u64)std::ceil(std::max(delay, 0.0f) / wheel.resolution);
+  ticks     = std::max<u64>(ticks, 1);
+
+  TimerWheelEntry& entry = wheel.entries[index];
+  entry.deadline         = wheel.current_tick + ticks;
+  entry.interval         = repeat ? ticks : 0;
+  entry.user_data        = user_data;
+  entry.is_scheduled     = true;
+
+  place_entry(wheel, index);
+
+  // Done!
+  return make_handle(index, entry.generation);
+}
+
+void timer_wheel_cancel(TimerWheel& wheel, const TimerWheelHandle handle) {
+  TimerWheelEntry* entry = get_entry(wheel, handle);
+  if(!entry) {
+    return;
+  }
+
+  // @NOTE: The entry is left in its slot, and will be 
+  // skipped once the slot is reached.
+
+  free_entry(wheel, (u32)(handle & 0xffffffff));
+}
+
+void timer_wheel_update(TimerWheel& wheel, const f32 delta_time, DynamicArray<u64>& out_expired) {
+  FREYA_PROFILE_FUNCTION();
+
+  wheel.accumulator += delta_time;
+  
+  TimerWheelSlot scratch;
+  while(wheel.accumulator >= wheel.resolution) {
+    wheel.accumulator -= wheel.resolution;
+    tick_wheel(wheel, scratch, out_expired);
+  }
+}
+
+bool timer_wheel_is_scheduled(const TimerWheel& wheel, const TimerWheelHandle handle) {
+  return get_entry(wheel, handle) != nullptr;
+}
+
+f32 timer_wheel_get_remaining(const TimerWheel& wheel, const TimerWheelHandle handle) {
+  TimerWheelEntry* entry = get_entry(wheel, handle);
+  if(!entry) {
+    return 0.0f;
+  }
+
+  f64 remaining = (f64)(entry->deadline - wheel.current_tick) * wheel.resolution - wheel.accumulator;
+  return (f32)std::max(remaining, 0.0);
+}
+
+/// TimerWheel functions
+///---------------------------------------------------------------------------------------------------------------------
+
 } // End of freya
 
 //////////////////////////////////////////////////////////////////////////
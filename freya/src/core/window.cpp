@@ -405,6 +405,14 @@ void window_poll_events(Window* window) {
   glfwPollEvents();
 }
 
+void window_wait_events(Window* window, const f64 timeout) {
+#if FREYA_PLATFORM_WEB != 1
+  glfwWaitEventsTimeout(timeout);
+#else
+  glfwPollEvents();
+#endif
+}
+
 void window_swap_buffers(Window* window, const i32 interval) {
 #if FREYA_PLATFORM_WEB != 1
   glfwSwapInterval(interval);
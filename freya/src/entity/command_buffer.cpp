@@ -0,0 +1,169 @@
+#include "freya_entity.h"
+#include "freya_event.h"
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace freya { // Start of freya
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static void play_creates(EntityWorld& world, DynamicArray<EntityCommand>& commands) {
+  if(commands.empty()) {
+    return;
+  }
+
+  // Generate all the entity IDs at once
+
+  DynamicArray<EntityID> entities(commands.size());
+  world.create(entities.begin(), entities.end());
+
+  DynamicArray<Transform> transforms;
+  transforms.reserve(commands.size());
+
+  for(auto& command : commands) {
+    transforms.push_back(command.transform);
+  }
+
+  world.insert<Transform>(entities.begin(), entities.end(), transforms.begin());
+  world.insert<TransformChanged>(entities.begin(), entities.end());
+
+  // Let the callers setup the rest of their entities
+
+  for(sizei i = 0; i < commands.size(); i++) {
+    if(commands[i].func) {
+      commands[i].func(world, entities[i]);
+    }
+  }
+
+  // Dispatch a single event for the whole batch
+
+  Event event = {
+    .type           = EVENT_ENTITIES_ADDED, 
+    .entities       = entities.data(),
+    .entities_count = entities.size(),
+  };
+  event_dispatch(event);
+}
+
+static void play_components(EntityWorld& world, 
+                            DynamicArray<EntityCommand>& commands, 
+                            const DynamicArray<EntityID>& destroyed) {
+  // Group the commands by their component type, so each pool is only touched once. 
+  // The sort is stable to keep the order of changes to the same component.
+
+  std::stable_sort(commands.begin(), commands.end(), [](const EntityCommand& a, const EntityCommand& b) {
+    if(a.component_id != b.component_id) {
+      return a.component_id < b.component_id;
+    }
+
+    return a.entt < b.entt;
+  });
+
+  for(auto& command : commands) {
+    if(!world.valid(command.entt)) {
+      continue;
+    }
+
+    // No point in changing an entity that is about to go away
+
+    if(std::binary_search(destroyed.begin(), destroyed.end(), command.entt)) {
+      continue;
+    }
+
+    command.func(world, command.entt);
+  }
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// EntityCommandBuffer functions
+
+void entity_command_buffer_push(EntityCommandBuffer& buffer, EntityCommand&& command) {
+  buffer.commands.enqueue(std::move(command));
+}
+
+void entity_command_buffer_create_entity(EntityCommandBuffer& buffer, 
+                                         const Vec2& position, 
+                                         const Vec2& scale, 
+                                         const f32 rotation, 
+                                         const EntityCommandFn& init_func) {
+  EntityCommand command = {
+    .type = ENTITY_COMMAND_CREATE, 
+    .func = init_func,
+  };
+
+  command.transform.position = position;
+  command.transform.scale    = scale;
+  command.transform.rotation = rotation;
+
+  entity_command_buffer_push(buffer, std::move(command));
+}
+
+void entity_command_buffer_destroy_entity(EntityCommandBuffer& buffer, const EntityID& entt) {
+  EntityCommand command = {
+    .type = ENTITY_COMMAND_DESTROY, 
+    .entt = entt,
+  };
+
+  entity_command_buffer_push(buffer, std::move(command));
+}
+
+void entity_command_buffer_playback(EntityWorld& world, EntityCommandBuffer& buffer) {
+  FREYA_PROFILE_FUNCTION();
+
+  // Take out everything recorded up until now
+  
+  DynamicArray<EntityCommand> commands(buffer.commands.size_approx());
+  if(commands.empty()) {
+    return;
+  }
+
+  sizei count = buffer.commands.try_dequeue_bulk(commands.begin(), commands.size());
+  commands.resize(count);
+
+  // Split the commands by their type
+  
+  DynamicArray<EntityCommand> creates, components;
+  DynamicArray<EntityID> destroyed;
+
+  for(auto& command : commands) {
+    switch(command.type) {
+      case ENTITY_COMMAND_CREATE:
+        creates.push_back(std::move(command));
+        break;
+      case ENTITY_COMMAND_DESTROY:
+        destroyed.push_back(command.entt);
+        break;
+      case ENTITY_COMMAND_EMPLACE:
+      case ENTITY_COMMAND_REMOVE:
+        components.push_back(std::move(command));
+        break;
+    }
+  }
+
+  // Make sure each entity is only destroyed once (and that it's still around)
+
+  std::sort(destroyed.begin(), destroyed.end());
+  destroyed.erase(std::unique(destroyed.begin(), destroyed.end()), destroyed.end());
+
+  auto invalid_it = std::remove_if(destroyed.begin(), destroyed.end(), [&](const EntityID entt) {
+    return !world.valid(entt);
+  });
+  destroyed.erase(invalid_it, destroyed.end());
+
+  // Play everything back in batches
+
+  play_creates(world, creates);
+  play_components(world, components, destroyed);
+  entity_destroy_many(world, destroyed);
+}
+
+/// EntityCommandBuffer functions
+/// ----------------------------------------------------------------------
+
+} // End of freya
+
+//////////////////////////////////////////////////////////////////////////
@@ -8,16 +8,63 @@
 
 namespace freya { // Start of freya
 
+/// ----------------------------------------------------------------------
+/// InterpolatedBody
+
+/// Given to the dynamic bodies that are still moving between 
+/// their last two states, and taken away once they settle down.
+struct InterpolatedBody {};
+
+/// InterpolatedBody
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+template<typename Comp, typename Fn>
+static void destroy_components(EntityWorld& world, const DynamicArray<EntityID>& entities, Fn destroy_func) {
+  // Most batches (bullets, tiles, etc.) never touch most of these 
+  // components, so there is no need to check each entity then.
+  
+  auto& storage = world.storage<Comp>();
+  if(storage.empty()) {
+    return;
+  }
+
+  for(auto& entt : entities) {
+    if(storage.contains(entt)) {
+      destroy_func(storage.get(entt));
+    }
+  }
+}
+
+template<typename Tag>
+static inline void mark_component(EntityWorld& world, const EntityID entt) {
+  auto& storage = world.storage<Tag>();
+
+  if(!storage.contains(entt)) {
+    storage.emplace(entt);
+  }
+}
+
+static void on_scheduled_timer_destroy(EntityWorld& world, const EntityID entt) {
+  ScheduledTimerComponent& comp = world.get<ScheduledTimerComponent>(entt);
+  timer_wheel_cancel(world.ctx().get<TimerWheel>(), comp.handle);
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// EntityWorld functions
 
 void entity_world_clear(EntityWorld& world) {
-  // Destroy each entity
+  // Destroy all the entities in one go
 
   auto view = world.view<EntityID>();
-  for(auto entt : view) {
-    entity_destroy(world, entt);
-  }
+  DynamicArray<EntityID> entities(view.begin(), view.end());
+
+  entity_destroy_many(world, entities);
 
   // Goodbye, cruel world!
   world.clear();
@@ -30,24 +77,98 @@ void entity_world_update(EntityWorld& world, const f32 delta_time) {
   {
     FREYA_PROFILE_FUNCTION_NAMED("entity_world_update(DynamicBodyComponent)");
 
-    auto view = world.view<DynamicBodyComponent, Transform>();
+    // Only the bodies that moved during the last steps have anything new to give
+
+    auto& bodies = world.storage<DynamicBodyComponent>();
+    for(auto& event : physics_world_get_move_events()) {
+      EntityID entt = (EntityID)event.user_data;
+
+      // The body might belong to another world (or to no entity at all)
+
+      if(!bodies.contains(entt) || !B2_ID_EQUALS(bodies.get(entt).body, event.body)) {
+        continue;
+      }
+
+      DynamicBodyComponent& body = bodies.get(entt);
+      if(body.last_step >= event.step) { // Already seen
+        continue;
+      }
+
+      body.previous_position = body.current_position;
+      body.previous_rotation = body.current_rotation;
+
+      body.current_position = event.position;
+      body.current_rotation = event.rotation;
+
+      body.last_step = event.step;
+      body.is_asleep = event.fell_asleep;
+
+      mark_component<InterpolatedBody>(world, entt);
+      if(event.fell_asleep) {
+        mark_component<BodyFellAsleep>(world, entt);
+      }
+    }
+
+    // Render in-between the last two steps 
+
+    u64 world_step = physics_world_get_steps_count();
+    f32 alpha      = physics_world_get_interpolation_alpha();
+
+    DynamicArray<EntityID> settled;
+
+    auto view = world.view<DynamicBodyComponent, Transform, InterpolatedBody>();
     for(auto entt : view) {
       DynamicBodyComponent& body = view.get<DynamicBodyComponent>(entt);
       Transform& transform       = view.get<Transform>(entt); 
 
-      transform.position = physics_body_get_position(body.body);
-      transform.rotation = physics_body_get_rotation(body.body);
+      // No events since the last step means the body stopped (or fell 
+      // asleep), so it can be put to rest at its final state.
+
+      if(body.last_step != world_step) {
+        body.previous_position = body.current_position;
+        body.previous_rotation = body.current_rotation;
+        
+        settled.push_back(entt);
+      }
+
+      f32 rotation_diff = body.current_rotation - body.previous_rotation;
+      rotation_diff     = glm::atan(glm::sin(rotation_diff), glm::cos(rotation_diff)); // Take the shortest arc
+
+      Vec2 position = vec2_lerp(body.previous_position, body.current_position, alpha);
+      f32 rotation  = body.previous_rotation + (rotation_diff * alpha);
+
+      if(transform.position == position && transform.rotation == rotation) {
+        continue;
+      }
+
+      transform.position = position;
+      transform.rotation = rotation;
+
+      mark_component<TransformChanged>(world, entt);
     }
+
+    world.remove<InterpolatedBody>(settled.begin(), settled.end());
   }
 
   // Animations
   {
     FREYA_PROFILE_FUNCTION_NAMED("entity_world_update(AnimationComponent)");
 
+    bool has_flipped = false;
+
     auto view = world.view<AnimationComponent>();
     for(auto entt : view) {
       AnimationComponent& anim = view.get<AnimationComponent>(entt);
+      IVec2 last_frame         = anim.animation.current_frame;
+
       animation_update(anim.animation, delta_time);
+      has_flipped |= (anim.animation.current_frame != last_frame);
+    }
+
+    // A new frame needs to be seen
+    
+    if(has_flipped) {
+      renderer_request_redraw();
     }
   }
 
@@ -55,10 +176,27 @@ void entity_world_update(EntityWorld& world, const f32 delta_time) {
   {
     FREYA_PROFILE_FUNCTION_NAMED("entity_world_update(Animator)");
 
+    bool has_flipped = false;
+
     auto view = world.view<Animator>();
     for(auto entt : view) {
       Animator& anim = view.get<Animator>(entt);
+      if(anim.animations.empty()) {
+        continue;
+      }
+
+      i32 last_animation = anim.current_animation;
+      IVec2 last_frame   = anim.animations[last_animation].current_frame;
+
       animator_update(anim, delta_time);
+      has_flipped |= (anim.current_animation != last_animation) || 
+                     (anim.animations[anim.current_animation].current_frame != last_frame);
+    }
+
+    // A new frame needs to be seen
+    
+    if(has_flipped) {
+      renderer_request_redraw();
     }
   }
 
@@ -77,16 +215,108 @@ void entity_world_update(EntityWorld& world, const f32 delta_time) {
     }
   }
 
+  // ScheduledTimers
+  if(world.ctx().contains<TimerWheel>()) {
+    FREYA_PROFILE_FUNCTION_NAMED("entity_world_update(ScheduledTimerComponent)");
+
+    TimerWheel& wheel = world.ctx().get<TimerWheel>();
+
+    DynamicArray<u64> expired;
+    timer_wheel_update(wheel, delta_time, expired);
+
+    // @NOTE: The callbacks might destroy entities, so the 
+    // storage is checked again for each expired timer.
+
+    auto& timers = world.storage<ScheduledTimerComponent>();
+    for(auto& data : expired) {
+      EntityID entt = (EntityID)data;
+      if(!timers.contains(entt)) {
+        continue;
+      }
+
+      ScheduledTimerComponent& comp = timers.get(entt);
+      if(!timer_wheel_is_scheduled(wheel, comp.handle)) { // One shot timers are gone by now
+        comp.handle = TIMER_WHEEL_HANDLE_INVALID;
+      }
+
+      if(comp.runout_func) {
+        comp.runout_func(world, entt, comp.user_data);
+      }
+    }
+  }
+
+  // Commands (every callback had its chance to record by now)
+  
+  if(world.ctx().contains<EntityCommandBuffer>()) {
+    entity_command_buffer_playback(world, world.ctx().get<EntityCommandBuffer>());
+  }
+
+  // Hierarchies (any children need to follow their parents before anyone else looks at them)
+  entity_world_update_hierarchy(world);
+
   // ParticleEmitters
   {
     FREYA_PROFILE_FUNCTION_NAMED("entity_world_update(ParticleEmitter)");
 
     auto view = world.view<ParticleEmitter>();
+
+    DynamicArray<ParticleEmitter*> emitters;
+    emitters.reserve(view.size());
+
+    for(auto entt : view) {
+      emitters.push_back(&view.get<ParticleEmitter>(entt));
+    }
+
+    // The emitters are all simulated together, so they can be spread across the workers
+    particle_emitters_update(emitters, delta_time);
+  }
+
+  // AudioSources (only the ones that moved)
+  {
+    FREYA_PROFILE_FUNCTION_NAMED("entity_world_update(AudioSourceID)");
+
+    auto view = world.view<AudioSourceID, Transform, TransformChanged>();
     for(auto entt : view) {
-      ParticleEmitter& emitter = view.get<ParticleEmitter>(entt);
-      particle_emitter_update(emitter, delta_time);
+      audio_source_set_position(view.get<AudioSourceID>(entt), view.get<Transform>(entt).position);
     }
   }
+
+  // Spatial index (if any) 
+  spatial_index_update(world);
+
+  // Anything that moved needs to be seen. This has to be
+  // checked now, since the renderer comes after the tags are gone.
+
+  if(!world.storage<TransformChanged>().empty()) {
+    renderer_request_redraw();
+  }
+
+  // Every system had its chance to see the changes by now
+
+  world.clear<TransformChanged>();
+  world.clear<BodyFellAsleep>();
+}
+
+TimerWheel& entity_world_get_timer_wheel(EntityWorld& world) {
+  if(world.ctx().contains<TimerWheel>()) {
+    return world.ctx().get<TimerWheel>();
+  }
+
+  TimerWheel& wheel = world.ctx().emplace<TimerWheel>();
+  timer_wheel_create(wheel);
+
+  // Take any timers of destroyed entities out of the wheel
+  world.on_destroy<ScheduledTimerComponent>().connect<&on_scheduled_timer_destroy>();
+
+  return wheel;
+}
+
+EntityCommandBuffer& entity_world_get_command_buffer(EntityWorld& world) {
+  if(world.ctx().contains<EntityCommandBuffer>()) {
+    return world.ctx().get<EntityCommandBuffer>();
+  }
+
+  return world.ctx().emplace<EntityCommandBuffer>();
 }
 
 /// EntityWorld functions
@@ -110,6 +340,7 @@ EntityID entity_create(EntityWorld& world,
   transform.scale    = scale;
 
   world.emplace<Transform>(entt_id, transform);
+  world.emplace<TransformChanged>(entt_id);
 
   // Dispatch an event
 
@@ -153,11 +384,91 @@ void entity_destroy(EntityWorld& world, EntityID& entt) {
     Animator& anim = entity_get_component<Animator>(world, entt);
     animator_clear(anim);
   }
+  
+  if(entity_has_component<ParticleEmitter>(world, entt)) {
+    ParticleEmitter& emitter = entity_get_component<ParticleEmitter>(world, entt);
+    particle_emitter_destroy(emitter);
+  }
 
   // Destroy the entity in the world
   world.destroy(entt); 
 }
 
+void entity_create_many(EntityWorld& world,
+                        DynamicArray<EntityID>& out_entities,
+                        const sizei count,
+                        const Vec2& position, 
+                        const Vec2& scale,
+                        const f32 rotation) {
+  // Generate all the entity IDs at once
+
+  out_entities.resize(count);
+  world.create(out_entities.begin(), out_entities.end());
+
+  // Add the same transform component to all of them
+
+  Transform transform; 
+  transform.position = position; 
+  transform.rotation = rotation; 
+  transform.scale    = scale;
+
+  world.insert<Transform>(out_entities.begin(), out_entities.end(), transform);
+  world.insert<TransformChanged>(out_entities.begin(), out_entities.end());
+
+  // Dispatch a single event for the whole batch
+
+  Event event = {
+    .type           = EVENT_ENTITIES_ADDED, 
+    .entities       = out_entities.data(),
+    .entities_count = out_entities.size(),
+  };
+  event_dispatch(event);
+}
+
+void entity_destroy_many(EntityWorld& world, const DynamicArray<EntityID>& entities) {
+  if(entities.empty()) {
+    return;
+  }
+
+  // Dispatch a single event for the whole batch
+
+  Event event = {
+    .type           = EVENT_ENTITIES_DESTROYED, 
+    .entities       = entities.data(),
+    .entities_count = entities.size(),
+  };
+  event_dispatch(event);
+
+  // Destroy any components that require it 
+
+  destroy_components<DynamicBodyComponent>(world, entities, [](DynamicBodyComponent& body) {
+    physics_body_destroy(body.body);
+  });
+  
+  destroy_components<StaticBodyComponent>(world, entities, [](StaticBodyComponent& body) {
+    physics_body_destroy(body.body);
+  });
+  
+  destroy_components<NoiseGenerator*>(world, entities, [](NoiseGenerator* gen) {
+    noise_generator_destroy(gen);
+  });
+  
+  destroy_components<Animator>(world, entities, [](Animator& anim) {
+    animator_clear(anim);
+  });
+  
+  destroy_components<ParticleEmitter>(world, entities, [](ParticleEmitter& emitter) {
+    particle_emitter_destroy(emitter);
+  });
+
+  // Destroy the entities in the world
+  world.destroy(entities.begin(), entities.end()); 
+}
+
+void entity_mark_transform_changed(EntityWorld& world, const EntityID& entt) {
+  mark_component<TransformChanged>(world, entt);
+}
+
 Camera& entity_add_camera(EntityWorld& world, EntityID& entt, CameraDesc& desc) {
   Transform& transform = world.get<Transform>(entt);
   desc.position        = transform.position;
@@ -259,6 +570,21 @@ TimerComponent& entity_add_timer(EntityWorld& world,
   return world.emplace<TimerComponent>(entt, timer, runout_func, user_data);
 }
 
+ScheduledTimerComponent& entity_add_scheduled_timer(EntityWorld& world, 
+                                                    EntityID& entt, 
+                                                    const TimerDesc& desc, 
+                                                    const OnTimerRunoutFn& runout_func, 
+                                                    void* user_data) {
+  TimerWheel& wheel = entity_world_get_timer_wheel(world);
+
+  TimerWheelHandle handle = TIMER_WHEEL_HANDLE_INVALID;
+  if(desc.initial_active) {
+    handle = timer_wheel_schedule(wheel, desc.limit, (u64)entt, !desc.one_shot);
+  }
+
+  return world.emplace<ScheduledTimerComponent>(entt, handle, runout_func, user_data);
+}
+
 UILayoutComponent& entity_add_ui_layout(EntityWorld& world, 
                                         EntityID& entt, 
                                         const OnUILayoutFn& layout_func, 
@@ -320,7 +646,20 @@ DynamicBodyComponent& entity_add_dynamic_body(EntityWorld& world,
   desc.user_data     = (uintptr)entt;
   PhysicsBodyID body = physics_body_create(desc);
 
-  return world.emplace<DynamicBodyComponent>(entt, body, enter_func, exit_func);
+  // Start with no interpolation, since the body has no history yet
+
+  DynamicBodyComponent& comp = world.emplace<DynamicBodyComponent>(entt, body, enter_func, exit_func);
+
+  comp.previous_position = transform.position;
+  comp.current_position  = transform.position;
+  
+  comp.previous_rotation = transform.rotation;
+  comp.current_rotation  = transform.rotation;
+
+  comp.last_step = physics_world_get_steps_count();
+
+  // Done!
+  return comp;
 }
 
 AnimationComponent& entity_add_animation(EntityWorld& world, EntityID& entt, const AnimationDesc& desc, const Vec4& tint) {
@@ -0,0 +1,305 @@
+#include "freya_entity.h"
+#include "freya_logger.h"
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace freya { // Start of freya
+
+/// ----------------------------------------------------------------------
+/// HierarchyState
+
+/// Lives in the context of any world that has a hierarchy.
+struct HierarchyState {
+  /// The amount of hierarchy passes so far, used to
+  /// never update the same entity twice in a single pass.
+  u64 passes_count = 0;
+};
+
+/// HierarchyState
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static inline Mat3 make_matrix(const Transform& transform) {
+  f32 cos_rot = freya::cos(transform.rotation);
+  f32 sin_rot = freya::sin(transform.rotation);
+
+  return Mat3(Vec3(cos_rot, sin_rot, 0.0f),
+              Vec3(-sin_rot, cos_rot, 0.0f),
+              Vec3(transform.position.x, transform.position.y, 1.0f));
+}
+
+static inline void mark_changed(EntityWorld& world, const EntityID entt) {
+  auto& storage = world.storage<TransformChanged>();
+
+  if(!storage.contains(entt)) {
+    storage.emplace(entt);
+  }
+}
+
+static void set_depth(EntityWorld& world, const EntityID root, const u32 depth) {
+  auto& storage = world.storage<HierarchyComponent>();
+
+  DynamicArray<EntityID> stack = {root};
+  storage.get(root).depth      = depth;
+
+  while(!stack.empty()) {
+    EntityID entt = stack.back();
+    stack.pop_back();
+
+    HierarchyComponent& node = storage.get(entt);
+
+    for(EntityID child = node.first_child; child != ENTITY_NULL; child = storage.get(child).next_sibling) {
+      storage.get(child).depth = node.depth + 1;
+      stack.push_back(child);
+    }
+  }
+}
+
+static void unlink_from_parent(EntityWorld& world, const EntityID entt) {
+  auto& storage            = world.storage<HierarchyComponent>();
+  HierarchyComponent& node = storage.get(entt);
+
+  if(node.parent == ENTITY_NULL) {
+    return;
+  }
+
+  // The parent might be already gone (if it's being destroyed along with us)
+
+  if(storage.contains(node.parent)) {
+    HierarchyComponent& parent = storage.get(node.parent);
+
+    if(parent.first_child == entt) {
+      parent.first_child = node.next_sibling;
+    }
+    parent.children_count--;
+  }
+
+  if(node.prev_sibling != ENTITY_NULL && storage.contains(node.prev_sibling)) {
+    storage.get(node.prev_sibling).next_sibling = node.next_sibling;
+  }
+
+  if(node.next_sibling != ENTITY_NULL && storage.contains(node.next_sibling)) {
+    storage.get(node.next_sibling).prev_sibling = node.prev_sibling;
+  }
+
+  node.parent       = ENTITY_NULL;
+  node.next_sibling = ENTITY_NULL;
+  node.prev_sibling = ENTITY_NULL;
+}
+
+static void on_hierarchy_destroy(EntityWorld& world, const EntityID entt) {
+  auto& storage = world.storage<HierarchyComponent>();
+  unlink_from_parent(world, entt);
+
+  // All the children become roots
+
+  HierarchyComponent& node = storage.get(entt);
+  EntityID child           = node.first_child;
+
+  while(child != ENTITY_NULL && storage.contains(child)) {
+    HierarchyComponent& child_node = storage.get(child);
+    EntityID next                  = child_node.next_sibling;
+
+    child_node.parent       = ENTITY_NULL;
+    child_node.next_sibling = ENTITY_NULL;
+    child_node.prev_sibling = ENTITY_NULL;
+
+    set_depth(world, child, 0);
+    child = next;
+  }
+
+  node.first_child    = ENTITY_NULL;
+  node.children_count = 0;
+}
+
+static HierarchyState& get_state(EntityWorld& world) {
+  if(world.ctx().contains<HierarchyState>()) {
+    return world.ctx().get<HierarchyState>();
+  }
+
+  // Fix up the hierarchy whenever an entity in it goes away
+  world.on_destroy<HierarchyComponent>().connect<&on_hierarchy_destroy>();
+
+  return world.ctx().emplace<HierarchyState>();
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// EntityWorld functions
+
+void entity_world_update_hierarchy(EntityWorld& world) {
+  FREYA_PROFILE_FUNCTION();
+
+  if(!world.ctx().contains<HierarchyState>()) {
+    return;
+  }
+
+  HierarchyState& state = world.ctx().get<HierarchyState>();
+  u64 pass              = ++state.passes_count;
+
+  auto& nodes      = world.storage<HierarchyComponent>();
+  auto& transforms = world.storage<Transform>();
+
+  // Only the entities that moved (and their subtrees) need any work.
+  // Going from the top down means that any parent gets done before its
+  // children, and that a subtree is never walked more than once.
+
+  DynamicArray<EntityID> dirty;
+
+  auto view = world.view<HierarchyComponent, TransformChanged>();
+  for(auto entt : view) {
+    dirty.push_back(entt);
+  }
+
+  std::sort(dirty.begin(), dirty.end(), [&](const EntityID a, const EntityID b) {
+    return nodes.get(a).depth < nodes.get(b).depth;
+  });
+
+  DynamicArray<EntityID> stack;
+  for(auto& root : dirty) {
+    if(nodes.get(root).last_pass == pass) { // Already done by one of its parents
+      continue;
+    }
+
+    stack.push_back(root);
+    while(!stack.empty()) {
+      EntityID entt = stack.back();
+      stack.pop_back();
+
+      HierarchyComponent& node = nodes.get(entt);
+      Transform& transform     = transforms.get(entt);
+
+      // Children follow their parents
+
+      if(node.parent != ENTITY_NULL) {
+        const HierarchyComponent& parent = nodes.get(node.parent);
+        const Transform& parent_trans    = transforms.get(node.parent);
+
+        Vec2 position = Vec2(parent.matrix * Vec3(node.local.position, 1.0f));
+        f32 rotation  = parent_trans.rotation + node.local.rotation;
+
+        if(transform.position != position || transform.rotation != rotation || transform.scale != node.local.scale) {
+          transform.position = position;
+          transform.rotation = rotation;
+          transform.scale    = node.local.scale;
+
+          mark_changed(world, entt);
+        }
+      }
+
+      node.matrix    = make_matrix(transform);
+      node.last_pass = pass;
+
+      for(EntityID child = node.first_child; child != ENTITY_NULL; child = nodes.get(child).next_sibling) {
+        stack.push_back(child);
+      }
+    }
+  }
+}
+
+/// EntityWorld functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// EntityID functions
+
+bool entity_set_parent(EntityWorld& world, EntityID& entt, const EntityID& parent) {
+  FREYA_DEBUG_ASSERT(world.valid(entt), "Cannot set the parent of an invalid entity");
+
+  get_state(world);
+
+  // @NOTE: Both components are added first, since adding one
+  // could move the other one around in memory.
+
+  world.get_or_emplace<HierarchyComponent>(entt);
+  if(parent != ENTITY_NULL) {
+    world.get_or_emplace<HierarchyComponent>(parent);
+  }
+
+  auto& nodes = world.storage<HierarchyComponent>();
+
+  // No loops allowed!
+
+  for(EntityID ancestor = parent; ancestor != ENTITY_NULL; ancestor = nodes.get(ancestor).parent) {
+    if(ancestor == entt) {
+      FREYA_LOG_ERROR("Cannot make an entity a child of itself (or of any of its own children)");
+      return false;
+    }
+  }
+
+  unlink_from_parent(world, entt);
+
+  HierarchyComponent& node = nodes.get(entt);
+  if(parent == ENTITY_NULL) {
+    set_depth(world, entt, 0);
+    return true;
+  }
+
+  // Link the entity as the first child of the parent
+
+  HierarchyComponent& parent_node = nodes.get(parent);
+
+  node.parent       = parent;
+  node.next_sibling = parent_node.first_child;
+
+  if(parent_node.first_child != ENTITY_NULL) {
+    nodes.get(parent_node.first_child).prev_sibling = entt;
+  }
+
+  parent_node.first_child = entt;
+  parent_node.children_count++;
+
+  set_depth(world, entt, parent_node.depth + 1);
+
+  // Keep the entity where it is, by making its current
+  // transform relative to the parent.
+
+  const Transform& transform    = world.get<Transform>(entt);
+  const Transform& parent_trans = world.get<Transform>(parent);
+
+  Vec2 offset = transform.position - parent_trans.position;
+  f32 cos_rot = freya::cos(-parent_trans.rotation);
+  f32 sin_rot = freya::sin(-parent_trans.rotation);
+
+  node.local.position = Vec2((offset.x * cos_rot) - (offset.y * sin_rot), (offset.x * sin_rot) + (offset.y * cos_rot));
+  node.local.rotation = transform.rotation - parent_trans.rotation;
+  node.local.scale    = transform.scale;
+
+  // Done!
+
+  mark_changed(world, parent);
+  mark_changed(world, entt);
+
+  return true;
+}
+
+EntityID entity_get_parent(EntityWorld& world, EntityID& entt) {
+  HierarchyComponent* node = world.try_get<HierarchyComponent>(entt);
+  return node ? node->parent : ENTITY_NULL;
+}
+
+void entity_set_local_transform(EntityWorld& world, EntityID& entt, const Transform& local) {
+  get_state(world);
+
+  HierarchyComponent& node = world.get_or_emplace<HierarchyComponent>(entt);
+  node.local               = local;
+
+  // Roots have nothing to be relative to
+
+  if(node.parent == ENTITY_NULL) {
+    world.get<Transform>(entt) = local;
+  }
+
+  mark_changed(world, entt);
+}
+
+/// EntityID functions
+/// ----------------------------------------------------------------------
+
+} // End of freya
+
+//////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,320 @@
+#include "freya_entity.h"
+#include "freya_event.h"
+#include "freya_logger.h"
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace freya { // Start of freya
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static void read_number(lua_State* lua, const char* name, f32& out_value) {
+  if(lua_getfield(lua, -1, name) == LUA_TNUMBER) {
+    out_value = (f32)lua_tonumber(lua, -1);
+  }
+  lua_pop(lua, 1);
+}
+
+static void read_bool(lua_State* lua, const char* name, bool& out_value) {
+  if(lua_getfield(lua, -1, name) == LUA_TBOOLEAN) {
+    out_value = lua_toboolean(lua, -1);
+  }
+  lua_pop(lua, 1);
+}
+
+static void read_string(lua_State* lua, const char* name, String& out_value) {
+  if(lua_getfield(lua, -1, name) == LUA_TSTRING) {
+    out_value = lua_tostring(lua, -1);
+  }
+  lua_pop(lua, 1);
+}
+
+static void read_numbers(lua_State* lua, const char* name, f32* out_values, const i32 count) {
+  if(lua_getfield(lua, -1, name) == LUA_TTABLE) {
+    for(i32 i = 0; i < count; i++) {
+      lua_geti(lua, -1, i + 1);
+      out_values[i] = (f32)lua_tonumber(lua, -1);
+      lua_pop(lua, 1);
+    }
+  }
+  lua_pop(lua, 1);
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Prefab functions
+
+void prefab_create(Prefab& out_prefab, const PrefabDesc& desc, const AssetGroupID& group_id) {
+  out_prefab = Prefab{};
+
+  // Transform init
+
+  out_prefab.transform.scale    = desc.scale;
+  out_prefab.transform.rotation = desc.rotation;
+
+  // Components init
+
+  if(!desc.tag.empty()) {
+    prefab_add_tag(out_prefab, desc.tag);
+  }
+
+  if(!desc.texture.empty()) {
+    prefab_add_sprite(out_prefab, asset_group_get_id(group_id, desc.texture), desc.color, desc.source, desc.layer);
+  }
+
+  if(desc.has_body) {
+    PhysicsBodyDesc body_desc = {
+      .type           = desc.body_type,
+      .linear_damping = desc.linear_damping,
+      .gravity_factor = desc.gravity_factor,
+      .rotation_fixed = desc.rotation_fixed,
+    };
+
+    prefab_add_body(out_prefab, body_desc, desc.collider, desc.collider_extents);
+  }
+}
+
+void prefab_create(Prefab& out_prefab, const AssetID& prefab_id) {
+  prefab_create(out_prefab, *asset_group_get_prefab(prefab_id), prefab_id.get_group());
+}
+
+bool prefab_desc_load(PrefabDesc& out_desc, lua_State* lua) {
+  // Make sure the file actually has a prefab table
+
+  if(lua_getglobal(lua, "prefab") != LUA_TTABLE) {
+    FREYA_LOG_ERROR("Could not find a \'prefab\' table in the given prefab file");
+
+    lua_pop(lua, 1);
+    return false;
+  }
+
+  // Transform
+
+  read_numbers(lua, "scale", &out_desc.scale[0], 2);
+  read_number(lua, "rotation", out_desc.rotation);
+
+  // Tag
+  read_string(lua, "tag", out_desc.tag);
+
+  // Sprite
+
+  if(lua_getfield(lua, -1, "sprite") == LUA_TTABLE) {
+    read_string(lua, "texture", out_desc.texture);
+    read_numbers(lua, "color", &out_desc.color[0], 4);
+
+    f32 source[4] = {
+      out_desc.source.position.x, out_desc.source.position.y,
+      out_desc.source.size.x, out_desc.source.size.y,
+    };
+    read_numbers(lua, "source", source, 4);
+
+    out_desc.source.position = Vec2(source[0], source[1]);
+    out_desc.source.size     = Vec2(source[2], source[3]);
+
+    f32 layer = (f32)out_desc.layer;
+    read_number(lua, "layer", layer);
+    out_desc.layer = (i32)layer;
+  }
+  lua_pop(lua, 1);
+
+  // Body
+
+  if(lua_getfield(lua, -1, "body") == LUA_TTABLE) {
+    out_desc.has_body = true;
+
+    // @NOTE: Yes, string comparisons. Leave me alone.
+
+    String type_str;
+    read_string(lua, "type", type_str);
+
+    if(type_str == "static") {
+      out_desc.body_type = PHYSICS_BODY_STATIC;
+    }
+    else if(type_str == "kinematic") {
+      out_desc.body_type = PHYSICS_BODY_KINEMATIC;
+    }
+    else if(type_str == "dynamic") {
+      out_desc.body_type = PHYSICS_BODY_DYNAMIC;
+    }
+
+    read_number(lua, "gravity_factor", out_desc.gravity_factor);
+    read_number(lua, "linear_damping", out_desc.linear_damping);
+    read_bool(lua, "rotation_fixed", out_desc.rotation_fixed);
+
+    read_numbers(lua, "extents", &out_desc.collider_extents[0], 2);
+    read_number(lua, "density", out_desc.collider.density);
+    read_number(lua, "friction", out_desc.collider.friction);
+    read_number(lua, "restitution", out_desc.collider.restitution);
+    read_bool(lua, "sensor", out_desc.collider.is_sensor);
+  }
+  lua_pop(lua, 1);
+
+  // Done!
+
+  lua_pop(lua, 1);
+  return true;
+}
+
+void prefab_add_sprite(Prefab& prefab,
+                       const AssetID& texture_id,
+                       const Vec4& color,
+                       const Rect2D& source,
+                       const i32 layer) {
+  // Resolve the texture once, here, instead of on every instance
+
+  Texture texture = {};
+  if(texture_id.get_id() != ASSET_ID_INVALID) {
+    texture = asset_group_get_texture(texture_id);
+  }
+
+  Rect2D src_rect = source;
+  if(source.size.x == 0.0f && source.size.y == 0.0f) {
+    src_rect.size = texture.size;
+  }
+
+  // Done!
+
+  prefab.sprite      = SpriteComponent{texture, src_rect, color, layer};
+  prefab.components |= PREFAB_COMPONENT_SPRITE;
+}
+
+void prefab_add_animation(Prefab& prefab, const AnimationDesc& desc, const Vec4& tint) {
+  animation_create(prefab.animation.animation, desc);
+  prefab.animation.tint = tint;
+
+  prefab.components |= PREFAB_COMPONENT_ANIMATION;
+}
+
+void prefab_add_tag(Prefab& prefab, const String& tag) {
+  prefab.tag.tag     = tag;
+  prefab.components |= PREFAB_COMPONENT_TAG;
+}
+
+void prefab_add_body(Prefab& prefab,
+                     const PhysicsBodyDesc& desc,
+                     const ColliderDesc& collider_desc,
+                     const Vec2& extents,
+                     const OnCollisionFn& enter_func,
+                     const OnCollisionFn& exit_func) {
+  prefab.body_desc        = desc;
+  prefab.collider_desc    = collider_desc;
+  prefab.collider_extents = extents;
+
+  prefab.enter_func = enter_func;
+  prefab.exit_func  = exit_func;
+
+  prefab.components |= PREFAB_COMPONENT_BODY;
+}
+
+void prefab_instantiate(EntityWorld& world,
+                        const Prefab& prefab,
+                        const Vec2* positions,
+                        const sizei count,
+                        DynamicArray<EntityID>& out_entities) {
+  FREYA_PROFILE_FUNCTION();
+
+  // Generate all the entity IDs at once
+
+  out_entities.resize(count);
+  world.create(out_entities.begin(), out_entities.end());
+
+  auto first = out_entities.begin();
+  auto last  = out_entities.end();
+
+  // Transforms (the only component that differs between instances)
+
+  DynamicArray<Transform> transforms(count, prefab.transform);
+  for(sizei i = 0; i < count; i++) {
+    transforms[i].position = positions[i];
+  }
+
+  world.insert<Transform>(first, last, transforms.begin());
+  world.insert<TransformChanged>(first, last);
+
+  // Copy the rest of the components straight into their pools
+
+  if(prefab.components & PREFAB_COMPONENT_TAG) {
+    world.insert<TagComponent>(first, last, prefab.tag);
+  }
+
+  if(prefab.components & PREFAB_COMPONENT_SPRITE) {
+    world.insert<SpriteComponent>(first, last, prefab.sprite);
+  }
+
+  if(prefab.components & PREFAB_COMPONENT_ANIMATION) {
+    world.insert<AnimationComponent>(first, last, prefab.animation);
+  }
+
+  // Bodies cannot be copied, so each instance needs its own
+
+  if(prefab.components & PREFAB_COMPONENT_BODY) {
+    PhysicsBodyDesc body_desc = prefab.body_desc;
+    body_desc.rotation        = prefab.transform.rotation;
+
+    bool is_static = (body_desc.type == PHYSICS_BODY_STATIC);
+
+    DynamicArray<StaticBodyComponent> static_bodies;
+    DynamicArray<DynamicBodyComponent> dynamic_bodies;
+
+    if(is_static) {
+      static_bodies.reserve(count);
+    }
+    else {
+      dynamic_bodies.reserve(count);
+    }
+
+    u64 world_step = physics_world_get_steps_count();
+
+    for(sizei i = 0; i < count; i++) {
+      body_desc.position  = positions[i];
+      body_desc.user_data = (uintptr)out_entities[i];
+
+      PhysicsBodyID body = physics_body_create(body_desc);
+      collider_create(body, prefab.collider_desc, prefab.collider_extents);
+
+      if(is_static) {
+        static_bodies.push_back(StaticBodyComponent{body, prefab.enter_func, prefab.exit_func});
+        continue;
+      }
+
+      // Start with no interpolation, since the body has no history yet
+
+      DynamicBodyComponent comp = {body, prefab.enter_func, prefab.exit_func};
+
+      comp.previous_position = positions[i];
+      comp.current_position  = positions[i];
+
+      comp.previous_rotation = body_desc.rotation;
+      comp.current_rotation  = body_desc.rotation;
+
+      comp.last_step = world_step;
+      dynamic_bodies.push_back(comp);
+    }
+
+    if(is_static) {
+      world.insert<StaticBodyComponent>(first, last, static_bodies.begin());
+    }
+    else {
+      world.insert<DynamicBodyComponent>(first, last, dynamic_bodies.begin());
+    }
+  }
+
+  // Dispatch a single event for the whole batch
+
+  Event event = {
+    .type           = EVENT_ENTITIES_ADDED,
+    .entities       = out_entities.data(),
+    .entities_count = out_entities.size(),
+  };
+  event_dispatch(event);
+}
+
+/// Prefab functions
+/// ----------------------------------------------------------------------
+
+} // End of freya
+
+//////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,491 @@
+#include "freya_entity.h"
+#include "freya_event.h"
+#include "freya_logger.h"
+
+#include <cstring>
+#include <type_traits>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace freya { // Start of freya
+
+/// ----------------------------------------------------------------------
+/// Consts
+
+/// The magic number at the start of any scene file ("FRSC").
+const u32 SCENE_MAGIC = 0x43535246;
+
+/// Consts
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// SceneBlockType
+enum SceneBlockType {
+  SCENE_BLOCK_TRANSFORM = 0,
+  SCENE_BLOCK_SPRITE,
+  SCENE_BLOCK_TIMER,
+  SCENE_BLOCK_TAG,
+};
+/// SceneBlockType
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// SceneHeader
+struct SceneHeader {
+  u32 magic;
+  u32 version;
+
+  u32 entities_count;
+  u32 names_count;
+  u32 blocks_count;
+};
+/// SceneHeader
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// SceneBlockHeader
+struct SceneBlockHeader {
+  u32 type;
+  u32 count;
+
+  u32 record_size; // `0` for blocks with variable-sized records
+  u32 data_size;
+};
+/// SceneBlockHeader
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// SceneSprite
+struct SceneSprite {
+  Rect2D source;
+  Vec4 color;
+
+  i32 layer;
+  i32 texture; // Index into the names table, or `-1` for the default texture
+};
+/// SceneSprite
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static_assert(std::is_trivially_copyable<Transform>::value, "Transform must be trivially copyable to be saved as-is");
+static_assert(std::is_trivially_copyable<Timer>::value, "Timer must be trivially copyable to be saved as-is");
+static_assert(std::is_trivially_copyable<SceneSprite>::value, "SceneSprite must be trivially copyable to be saved as-is");
+
+static void write_padding(File& file, const sizei written) {
+  // Every section starts at an 8-byte boundary, so that the
+  // records can be read straight out of the mapped file.
+
+  const u8 zeros[8] = {};
+  sizei padding     = (8 - (written % 8)) % 8;
+
+  file_write_bytes(file, zeros, padding);
+}
+
+static sizei align_offset(const sizei offset) {
+  return (offset + 7) & ~(sizei)7;
+}
+
+template<typename Record>
+static void write_block(File& file, const SceneBlockType type, const DynamicArray<u32>& indices, const DynamicArray<Record>& records) {
+  SceneBlockHeader header = {
+    .type        = (u32)type,
+    .count       = (u32)indices.size(),
+    .record_size = (u32)sizeof(Record),
+    .data_size   = (u32)(records.size() * sizeof(Record)),
+  };
+
+  file_write_bytes(file, &header, sizeof(header));
+
+  file_write_bytes(file, indices.data(), indices.size() * sizeof(u32));
+  write_padding(file, sizeof(header) + (indices.size() * sizeof(u32)));
+
+  file_write_bytes(file, records.data(), header.data_size);
+  write_padding(file, header.data_size);
+}
+
+static bool validate_blocks(const FileMapping& mapping, const sizei blocks_offset, const SceneHeader& header) {
+  sizei offset = blocks_offset;
+
+  // The last block each entity was seen in (`0` being none), 
+  // so it never has to be cleared between blocks
+  DynamicArray<u32> last_seen(header.entities_count, 0);
+
+  for(u32 i = 0; i < header.blocks_count; i++) {
+    if(offset + sizeof(SceneBlockHeader) > mapping.size) {
+      return false;
+    }
+
+    SceneBlockHeader block;
+    memcpy(&block, mapping.data + offset, sizeof(block));
+
+    // The records (if fixed) must cover exactly what the block claims
+
+    if(block.record_size != 0 && ((u64)block.record_size * block.count) != block.data_size) {
+      return false;
+    }
+
+    sizei indices_offset = offset + sizeof(block);
+    sizei data_offset    = align_offset(indices_offset + (block.count * sizeof(u32)));
+
+    if(data_offset + block.data_size > mapping.size) {
+      return false;
+    }
+
+    // All the indices must point to entities in the file, 
+    // and no entity can show up twice in the same block
+
+    const u32* indices = (const u32*)(mapping.data + indices_offset);
+    for(u32 j = 0; j < block.count; j++) {
+      if(indices[j] >= header.entities_count) {
+        return false;
+      }
+
+      if(last_seen[indices[j]] == (i + 1)) {
+        return false;
+      }
+      last_seen[indices[j]] = i + 1;
+    }
+
+    offset = align_offset(data_offset + block.data_size);
+  }
+
+  return true;
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// EntityWorld functions
+
+bool entity_world_save(EntityWorld& world, const FilePath& path, const AssetGroupID& group_id) {
+  FREYA_PROFILE_FUNCTION();
+
+  File file;
+  if(!file_open(file, path, (i32)(FILE_OPEN_WRITE | FILE_OPEN_BINARY | FILE_OPEN_TRUNCATE))) {
+    FREYA_LOG_ERROR("Failed to open scene file at \'%s\'", path.c_str());
+    return false;
+  }
+
+  // Give each entity a local index in the file
+
+  HashMap<EntityID, u32> indices;
+  u32 entities_count = 0;
+
+  for(auto entt : world.view<EntityID>()) {
+    indices[entt] = entities_count++;
+  }
+
+  // Asset references are saved as names, with each name only saved once
+
+  DynamicArray<String> names;
+  HashMap<i32, i32> texture_names;
+
+  auto get_texture_name = [&](const Texture& texture) -> i32 {
+    if(texture.id == -1) {
+      return -1;
+    }
+
+    auto it = texture_names.find(texture.id);
+    if(it != texture_names.end()) {
+      return it->second;
+    }
+
+    // Make sure the texture actually comes from this group
+
+    AssetID id(ASSET_TYPE_TEXTURE, group_id, (i16)texture.id);
+    String name = asset_group_get_name(id);
+
+    i32 index = -1;
+    if(!name.empty() && asset_group_get_texture(id).image.id == texture.image.id) {
+      index = (i32)names.size();
+      names.push_back(name);
+    }
+    else {
+      FREYA_LOG_WARN("Could not find the name of a texture in the given group. It will not be saved");
+    }
+
+    texture_names[texture.id] = index;
+    return index;
+  };
+
+  //
+  // Gather all of the blocks
+  //
+
+  DynamicArray<u32> transform_indices;
+  DynamicArray<Transform> transforms;
+
+  for(auto [entt, transform] : world.view<Transform>().each()) {
+    transform_indices.push_back(indices[entt]);
+    transforms.push_back(transform);
+  }
+
+  DynamicArray<u32> sprite_indices;
+  DynamicArray<SceneSprite> sprites;
+
+  for(auto [entt, sprite] : world.view<SpriteComponent>().each()) {
+    sprite_indices.push_back(indices[entt]);
+    sprites.push_back(SceneSprite {
+      .source  = sprite.source_rect,
+      .color   = sprite.color,
+      .layer   = sprite.layer,
+      .texture = get_texture_name(sprite.texture),
+    });
+  }
+
+  DynamicArray<u32> timer_indices;
+  DynamicArray<Timer> timers;
+
+  for(auto [entt, comp] : world.view<TimerComponent>().each()) {
+    timer_indices.push_back(indices[entt]);
+    timers.push_back(comp.timer);
+  }
+
+  DynamicArray<u32> tag_indices;
+  DynamicArray<u8> tags;
+
+  for(auto [entt, comp] : world.view<TagComponent>().each()) {
+    tag_indices.push_back(indices[entt]);
+
+    u32 length = (u32)comp.tag.size();
+    tags.insert(tags.end(), (u8*)&length, (u8*)&length + sizeof(length));
+    tags.insert(tags.end(), comp.tag.begin(), comp.tag.end());
+  }
+
+  //
+  // Write the file
+  //
+
+  // Write the header
+
+  SceneHeader header = {
+    .magic          = SCENE_MAGIC,
+    .version        = SCENE_VALID_VERSION,
+    .entities_count = entities_count,
+    .names_count    = (u32)names.size(),
+    .blocks_count   = 4,
+  };
+  file_write_bytes(file, &header, sizeof(header));
+
+  // Write the names
+
+  sizei names_size = 0;
+  for(auto& name : names) {
+    file_write_bytes(file, name);
+    names_size += sizeof(u32) + name.size();
+  }
+  write_padding(file, sizeof(header) + names_size);
+
+  // Write the blocks
+
+  write_block(file, SCENE_BLOCK_TRANSFORM, transform_indices, transforms);
+  write_block(file, SCENE_BLOCK_SPRITE, sprite_indices, sprites);
+  write_block(file, SCENE_BLOCK_TIMER, timer_indices, timers);
+
+  // Tags are variable in size, so they are written as a stream instead
+
+  SceneBlockHeader tags_header = {
+    .type        = SCENE_BLOCK_TAG,
+    .count       = (u32)tag_indices.size(),
+    .record_size = 0,
+    .data_size   = (u32)tags.size(),
+  };
+
+  file_write_bytes(file, &tags_header, sizeof(tags_header));
+
+  file_write_bytes(file, tag_indices.data(), tag_indices.size() * sizeof(u32));
+  write_padding(file, sizeof(tags_header) + (tag_indices.size() * sizeof(u32)));
+
+  file_write_bytes(file, tags.data(), tags.size());
+  write_padding(file, tags.size());
+
+  // Done!
+
+  file_close(file);
+  FREYA_LOG_DEBUG("Saved %u entities to scene at \'%s\'", header.entities_count, path.c_str());
+
+  return true;
+}
+
+bool entity_world_load(EntityWorld& world, const FilePath& path, const AssetGroupID& group_id, DynamicArray<EntityID>& out_entities) {
+  FREYA_PROFILE_FUNCTION();
+
+  FileMapping mapping;
+  if(!file_map(mapping, path)) {
+    FREYA_LOG_ERROR("Failed to load scene file at \'%s\'", path.c_str());
+    return false;
+  }
+
+  // Read and validate the header
+
+  SceneHeader header = {};
+  if(mapping.size >= sizeof(header)) {
+    memcpy(&header, mapping.data, sizeof(header));
+  }
+
+  if(header.magic != SCENE_MAGIC || header.version != SCENE_VALID_VERSION) {
+    FREYA_LOG_ERROR("Invalid scene file at \'%s\'. Expected version \'%u\', but found \'%u\'", path.c_str(), SCENE_VALID_VERSION, header.version);
+
+    file_unmap(mapping);
+    return false;
+  }
+
+  // Resolve all of the names once
+
+  sizei offset = sizeof(header);
+  DynamicArray<Texture> textures(header.names_count);
+
+  for(u32 i = 0; i < header.names_count; i++) {
+    u32 length = 0;
+    if(offset + sizeof(length) <= mapping.size) {
+      memcpy(&length, mapping.data + offset, sizeof(length));
+    }
+
+    if(offset + sizeof(length) + length > mapping.size) {
+      FREYA_LOG_ERROR("Corrupted names in scene file at \'%s\'", path.c_str());
+
+      file_unmap(mapping);
+      return false;
+    }
+
+    String name((const char*)mapping.data + offset + sizeof(length), length);
+    offset += sizeof(length) + length;
+
+    const AssetID& id = asset_group_get_id(group_id, name);
+    if(id.get_id() != ASSET_ID_INVALID) {
+      textures[i] = asset_group_get_texture(id);
+    }
+  }
+  offset = align_offset(offset);
+
+  // Make sure the blocks are sane before touching the world
+
+  if(!validate_blocks(mapping, offset, header)) {
+    FREYA_LOG_ERROR("Corrupted blocks in scene file at \'%s\'", path.c_str());
+
+    file_unmap(mapping);
+    return false;
+  }
+
+  // Create all the entities at once
+
+  out_entities.resize(header.entities_count);
+  world.create(out_entities.begin(), out_entities.end());
+
+  // Insert each block into its pool
+
+  DynamicArray<EntityID> block_entities;
+
+  for(u32 i = 0; i < header.blocks_count; i++) {
+    SceneBlockHeader block;
+    memcpy(&block, mapping.data + offset, sizeof(block));
+
+    const u32* indices = (const u32*)(mapping.data + offset + sizeof(block));
+    const u8* data     = mapping.data + align_offset(offset + sizeof(block) + (block.count * sizeof(u32)));
+
+    offset = align_offset((sizei)(data - mapping.data) + block.data_size);
+
+    // Map the local indices back to entities
+
+    block_entities.resize(block.count);
+    for(u32 j = 0; j < block.count; j++) {
+      block_entities[j] = out_entities[indices[j]];
+    }
+
+    auto first = block_entities.begin();
+    auto last  = block_entities.end();
+
+    switch(block.type) {
+      case SCENE_BLOCK_TRANSFORM: {
+        if(block.record_size != sizeof(Transform)) {
+          break;
+        }
+
+        world.insert<Transform>(first, last, (const Transform*)data);
+        world.insert<TransformChanged>(first, last);
+      } break;
+      case SCENE_BLOCK_SPRITE: {
+        if(block.record_size != sizeof(SceneSprite)) {
+          break;
+        }
+
+        const SceneSprite* records = (const SceneSprite*)data;
+
+        DynamicArray<SpriteComponent> sprites(block.count);
+        for(u32 j = 0; j < block.count; j++) {
+          i32 texture = records[j].texture;
+
+          sprites[j].texture     = (texture >= 0 && texture < (i32)textures.size()) ? textures[texture] : Texture{};
+          sprites[j].source_rect = records[j].source;
+          sprites[j].color       = records[j].color;
+          sprites[j].layer       = records[j].layer;
+        }
+
+        world.insert<SpriteComponent>(first, last, sprites.begin());
+      } break;
+      case SCENE_BLOCK_TIMER: {
+        if(block.record_size != sizeof(Timer)) {
+          break;
+        }
+
+        // @NOTE: Callbacks cannot be saved. They have to be given again after loading.
+
+        const Timer* records = (const Timer*)data;
+
+        DynamicArray<TimerComponent> timers(block.count);
+        for(u32 j = 0; j < block.count; j++) {
+          timers[j].timer = records[j];
+        }
+
+        world.insert<TimerComponent>(first, last, timers.begin());
+      } break;
+      case SCENE_BLOCK_TAG: {
+        sizei tag_offset = 0;
+
+        DynamicArray<TagComponent> tags(block.count);
+        for(u32 j = 0; j < block.count; j++) {
+          u32 length = 0;
+          if(tag_offset + sizeof(length) <= block.data_size) {
+            memcpy(&length, data + tag_offset, sizeof(length));
+          }
+          tag_offset += sizeof(length);
+
+          length = (u32)glm::min((sizei)length, block.data_size - glm::min((sizei)block.data_size, tag_offset));
+
+          tags[j].tag = String((const char*)data + tag_offset, length);
+          tag_offset += length;
+        }
+
+        world.insert<TagComponent>(first, last, tags.begin());
+      } break;
+      default:
+        break;
+    }
+  }
+
+  // Dispatch a single event for the whole scene
+
+  Event event = {
+    .type           = EVENT_ENTITIES_ADDED,
+    .entities       = out_entities.data(),
+    .entities_count = out_entities.size(),
+  };
+  event_dispatch(event);
+
+  // Done!
+
+  file_unmap(mapping);
+  FREYA_LOG_DEBUG("Loaded %u entities from scene at \'%s\'", header.entities_count, path.c_str());
+
+  return true;
+}
+
+/// EntityWorld functions
+/// ----------------------------------------------------------------------
+
+} // End of freya
+
+//////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,321 @@
+#include "freya_entity.h"
+#include "freya_logger.h"
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace freya { // Start of freya
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static inline IVec2 get_cell_coords(const SpatialIndex& index, const Vec2& position) {
+  return IVec2((i32)freya::floor(position.x / index.cell_size),
+               (i32)freya::floor(position.y / index.cell_size));
+}
+
+static inline u64 get_cell_key(const IVec2& coords) {
+  return ((u64)(u32)coords.x << 32) | (u64)(u32)coords.y;
+}
+
+static void remove_from_cell(SpatialIndex& index, const SpatialEntry& entry) {
+  DynamicArray<EntityID>& cell = index.cells[entry.cell];
+
+  // Swap the last entity in the cell into the removed slot
+
+  EntityID last = cell.back();
+
+  cell[entry.slot] = last;
+  cell.pop_back();
+
+  if(entry.slot < cell.size()) {
+    index.entries[last].slot = entry.slot;
+  }
+
+  if(cell.empty()) {
+    index.cells.erase(entry.cell);
+  }
+}
+
+static void add_to_cell(SpatialIndex& index, const EntityID entt, SpatialEntry& entry, const IVec2& coords) {
+  DynamicArray<EntityID>& cell = index.cells[entry.cell];
+
+  entry.slot = (u32)cell.size();
+  cell.push_back(entt);
+
+  // Grow the occupied range (starting over if this is the only entity)
+
+  if(index.entries.size() == 1) {
+    index.min_cell = coords;
+    index.max_cell = coords;
+  }
+
+  index.min_cell = glm::min(index.min_cell, coords);
+  index.max_cell = glm::max(index.max_cell, coords);
+}
+
+static void place_entity(SpatialIndex& index, const EntityID entt, const Vec2& position) {
+  IVec2 coords = get_cell_coords(index, position);
+  u64 key      = get_cell_key(coords);
+
+  // New entity
+
+  auto it = index.entries.find(entt);
+  if(it == index.entries.end()) {
+    SpatialEntry& entry = index.entries[entt];
+
+    entry.position = position;
+    entry.cell     = key;
+
+    add_to_cell(index, entt, entry, coords);
+    return;
+  }
+
+  // Only move the entity around if it actually changed cells
+
+  SpatialEntry& entry = it->second;
+  entry.position      = position;
+
+  if(entry.cell == key) {
+    return;
+  }
+
+  remove_from_cell(index, entry);
+
+  entry.cell = key;
+  add_to_cell(index, entt, entry, coords);
+}
+
+static void on_transform_destroy(SpatialIndex& index, EntityWorld& world, const EntityID entt) {
+  auto it = index.entries.find(entt);
+  if(it == index.entries.end()) {
+    return;
+  }
+
+  remove_from_cell(index, it->second);
+  index.entries.erase(it);
+}
+
+template<typename Fn>
+static void iterate_cells(SpatialIndex& index, const Vec2& min, const Vec2& max, Fn func) {
+  IVec2 min_cell = glm::max(get_cell_coords(index, min), index.min_cell);
+  IVec2 max_cell = glm::min(get_cell_coords(index, max), index.max_cell);
+
+  for(i32 y = min_cell.y; y <= max_cell.y; y++) {
+    for(i32 x = min_cell.x; x <= max_cell.x; x++) {
+      auto it = index.cells.find(get_cell_key(IVec2(x, y)));
+      if(it == index.cells.end()) {
+        continue;
+      }
+
+      for(auto& entt : it->second) {
+        func(entt, index.entries[entt].position);
+      }
+    }
+  }
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Spatial index functions
+
+void spatial_index_create(EntityWorld& world, const f32 cell_size) {
+  FREYA_DEBUG_ASSERT((cell_size > 0.0f), "Cannot create a spatial index with a cell size of 0");
+
+  if(world.ctx().contains<SpatialIndex>()) {
+    spatial_index_destroy(world);
+  }
+
+  SpatialIndex& index = world.ctx().emplace<SpatialIndex>();
+  index.cell_size     = cell_size;
+
+  // Get rid of destroyed entities as soon as they go away
+  world.on_destroy<Transform>().connect<&on_transform_destroy>(index);
+
+  // Fill the index with everything that is already in the world
+
+  auto view = world.view<Transform>();
+  for(auto entt : view) {
+    place_entity(index, entt, view.get<Transform>(entt).position);
+  }
+}
+
+void spatial_index_destroy(EntityWorld& world) {
+  if(!world.ctx().contains<SpatialIndex>()) {
+    return;
+  }
+
+  SpatialIndex& index = world.ctx().get<SpatialIndex>();
+  world.on_destroy<Transform>().disconnect<&on_transform_destroy>(index);
+
+  world.ctx().erase<SpatialIndex>();
+}
+
+void spatial_index_update(EntityWorld& world) {
+  FREYA_PROFILE_FUNCTION();
+
+  if(!world.ctx().contains<SpatialIndex>()) {
+    return;
+  }
+
+  SpatialIndex& index = world.ctx().get<SpatialIndex>();
+
+  // Only the entities that moved could have changed cells
+
+  auto view = world.view<Transform, TransformChanged>();
+  for(auto entt : view) {
+    place_entity(index, entt, view.get<Transform>(entt).position);
+  }
+}
+
+SpatialIndex& spatial_index_get(EntityWorld& world) {
+  FREYA_DEBUG_ASSERT(world.ctx().contains<SpatialIndex>(), "The given world does not have a spatial index");
+  return world.ctx().get<SpatialIndex>();
+}
+
+sizei spatial_index_query_radius(EntityWorld& world,
+                                 const Vec2& center,
+                                 const f32 radius,
+                                 EntityID* out_entities,
+                                 const sizei capacity) {
+  SpatialIndex& index = spatial_index_get(world);
+
+  sizei count     = 0;
+  f32 radius_sqrd = radius * radius;
+
+  iterate_cells(index, center - Vec2(radius), center + Vec2(radius), [&](const EntityID entt, const Vec2& position) {
+    Vec2 diff = position - center;
+
+    if(count < capacity && glm::dot(diff, diff) <= radius_sqrd) {
+      out_entities[count++] = entt;
+    }
+  });
+
+  return count;
+}
+
+sizei spatial_index_query_rect(EntityWorld& world,
+                               const Rect2D& bounds,
+                               EntityID* out_entities,
+                               const sizei capacity) {
+  SpatialIndex& index = spatial_index_get(world);
+
+  sizei count = 0;
+  Vec2 min    = bounds.position;
+  Vec2 max    = bounds.position + bounds.size;
+
+  iterate_cells(index, min, max, [&](const EntityID entt, const Vec2& position) {
+    bool is_inside = (position.x >= min.x && position.x <= max.x) &&
+                     (position.y >= min.y && position.y <= max.y);
+
+    if(count < capacity && is_inside) {
+      out_entities[count++] = entt;
+    }
+  });
+
+  return count;
+}
+
+sizei spatial_index_query_nearest(EntityWorld& world,
+                                  const Vec2& center,
+                                  const sizei count,
+                                  EntityID* out_entities,
+                                  const f32 max_distance) {
+  SpatialIndex& index = spatial_index_get(world);
+  if(count == 0 || index.entries.empty()) {
+    return 0;
+  }
+
+  // The closest entities found so far, sorted by their distance
+
+  DynamicArray<f32> distances(count);
+
+  sizei found       = 0;
+  f32 max_dist_sqrd = (max_distance == FLT_MAX) ? FLT_MAX : (max_distance * max_distance);
+
+  auto try_insert = [&](const EntityID entt, const Vec2& position) {
+    Vec2 diff     = position - center;
+    f32 dist_sqrd = glm::dot(diff, diff);
+
+    if(dist_sqrd > max_dist_sqrd || (found == count && dist_sqrd >= distances[found - 1])) {
+      return;
+    }
+
+    // Shift the further entities back to make room
+
+    sizei slot = (found < count) ? found++ : (count - 1);
+
+    while(slot > 0 && distances[slot - 1] > dist_sqrd) {
+      distances[slot]    = distances[slot - 1];
+      out_entities[slot] = out_entities[slot - 1];
+
+      slot--;
+    }
+
+    distances[slot]    = dist_sqrd;
+    out_entities[slot] = entt;
+  };
+
+  // Search in rings of cells around the center, going outwards
+
+  IVec2 center_cell = get_cell_coords(index, center);
+
+  i32 max_ring = glm::max(glm::max(glm::abs(center_cell.x - index.min_cell.x), glm::abs(index.max_cell.x - center_cell.x)),
+                          glm::max(glm::abs(center_cell.y - index.min_cell.y), glm::abs(index.max_cell.y - center_cell.y)));
+
+  if(max_distance != FLT_MAX) {
+    max_ring = glm::min(max_ring, (i32)(max_distance / index.cell_size) + 2);
+  }
+
+  auto visit_cell = [&](const i32 x, const i32 y) {
+    auto it = index.cells.find(get_cell_key(IVec2(x, y)));
+    if(it == index.cells.end()) {
+      return;
+    }
+
+    for(auto& entt : it->second) {
+      try_insert(entt, index.entries[entt].position);
+    }
+  };
+
+  for(i32 ring = 0; ring <= max_ring; ring++) {
+    // Any cell in this ring is at least `ring - 1` cells away from the
+    // center, so nothing in here can beat what was already found.
+
+    if(found == count) {
+      f32 ring_dist = (ring - 1) * index.cell_size;
+      if(ring_dist > 0.0f && (ring_dist * ring_dist) > distances[found - 1]) {
+        break;
+      }
+    }
+
+    if(ring == 0) {
+      visit_cell(center_cell.x, center_cell.y);
+      continue;
+    }
+
+    // Top and bottom rows of the ring
+
+    for(i32 x = -ring; x <= ring; x++) {
+      visit_cell(center_cell.x + x, center_cell.y - ring);
+      visit_cell(center_cell.x + x, center_cell.y + ring);
+    }
+
+    // Left and right columns of the ring (without the corners)
+
+    for(i32 y = -ring + 1; y <= ring - 1; y++) {
+      visit_cell(center_cell.x - ring, center_cell.y + y);
+      visit_cell(center_cell.x + ring, center_cell.y + y);
+    }
+  }
+
+  return found;
+}
+
+/// Spatial index functions
+/// ----------------------------------------------------------------------
+
+} // End of freya
+
+//////////////////////////////////////////////////////////////////////////
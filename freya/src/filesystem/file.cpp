@@ -1,8 +1,20 @@
 #include "freya_file.h"
 #include "freya_logger.h"
+#include "freya_memory.h"
 
 #include <sstream>
 
+#if FREYA_PLATFORM_WINDOWS == 1
+  #define WIN32_LEAN_AND_MEAN
+  #define NOMINMAX
+  #include <windows.h>
+#elif FREYA_PLATFORM_LINUX == 1
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
 //////////////////////////////////////////////////////////////////////////
 
 namespace freya { // Start of freya
@@ -156,6 +168,114 @@ void file_read_string(File& file, String* str) {
   *str = ss.str();
 }
 
+bool file_map(FileMapping& out_mapping, const FilePath& path) {
+  out_mapping = FileMapping{};
+
+#if FREYA_PLATFORM_WINDOWS == 1
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(file == INVALID_HANDLE_VALUE) {
+    FREYA_LOG_ERROR("Failed to open file at \'%s\' for mapping", path.c_str());
+    return false;
+  }
+
+  LARGE_INTEGER file_size; 
+  GetFileSizeEx(file, &file_size);
+
+  // Cannot map an empty file
+
+  if(file_size.QuadPart == 0) {
+    CloseHandle(file);
+    return false;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file); // The mapping keeps the file alive
+
+  if(!mapping) {
+    FREYA_LOG_ERROR("Failed to map file at \'%s\'", path.c_str());
+    return false;
+  }
+
+  out_mapping.data   = (const u8*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  out_mapping.size   = (sizei)file_size.QuadPart;
+  out_mapping.handle = mapping;
+
+#elif FREYA_PLATFORM_LINUX == 1
+  i32 file = open(path.c_str(), O_RDONLY);
+  if(file == -1) {
+    FREYA_LOG_ERROR("Failed to open file at \'%s\' for mapping", path.c_str());
+    return false;
+  }
+
+  struct stat file_stat;
+  fstat(file, &file_stat);
+
+  // Cannot map an empty file
+
+  if(file_stat.st_size == 0) {
+    close(file);
+    return false;
+  }
+
+  void* data = mmap(nullptr, (sizei)file_stat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+  close(file); // The mapping keeps the file alive
+
+  if(data == MAP_FAILED) {
+    FREYA_LOG_ERROR("Failed to map file at \'%s\'", path.c_str());
+    return false;
+  }
+
+  out_mapping.data = (const u8*)data;
+  out_mapping.size = (sizei)file_stat.st_size;
+
+#else
+  // No mapping here. Just read the whole thing.
+
+  File file;
+  if(!file_open(file, path, (i32)(FILE_OPEN_READ | FILE_OPEN_BINARY))) {
+    FREYA_LOG_ERROR("Failed to open file at \'%s\' for mapping", path.c_str());
+    return false;
+  }
+
+  file.seekg(0, std::ios::end);
+  sizei size = (sizei)file.tellg();
+  file.seekg(0, std::ios::beg);
+
+  if(size == 0) {
+    file_close(file);
+    return false;
+  }
+
+  void* data = memory_allocate(size);
+  file_read_bytes(file, data, size);
+  file_close(file);
+
+  out_mapping.data   = (const u8*)data;
+  out_mapping.size   = size;
+  out_mapping.handle = data;
+#endif
+
+  // Done!
+  return out_mapping.data != nullptr;
+}
+
+void file_unmap(FileMapping& mapping) {
+  if(!mapping.data) {
+    return;
+  }
+
+#if FREYA_PLATFORM_WINDOWS == 1
+  UnmapViewOfFile(mapping.data);
+  CloseHandle((HANDLE)mapping.handle);
+#elif FREYA_PLATFORM_LINUX == 1
+  munmap((void*)mapping.data, mapping.size);
+#else
+  memory_free(mapping.handle);
+#endif
+
+  mapping = FileMapping{};
+}
+
 /// File functions
 ///---------------------------------------------------------------------------------------------------------------------
 
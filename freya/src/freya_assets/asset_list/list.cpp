@@ -25,6 +25,18 @@ static void assign_section_paths(ListContext& list, const freya::String& asset_s
   section.directory = lua_tostring(list.lua_state, -1);
   lua_pop(list.lua_state, 1);
 
+  // Assign the (optional) texture settings of this section
+
+  if(lua_getfield(list.lua_state, -1, "mipmaps") == LUA_TBOOLEAN) {
+    section.has_mipmaps = lua_toboolean(list.lua_state, -1);
+  }
+  lua_pop(list.lua_state, 1);
+  
+  if(lua_getfield(list.lua_state, -1, "compress") == LUA_TBOOLEAN) {
+    section.is_compressed = lua_toboolean(list.lua_state, -1);
+  }
+  lua_pop(list.lua_state, 1);
+
   //
   // @TODO (Asset list): Add settings for extensions and indivisual items
   //
@@ -108,6 +120,8 @@ bool list_context_load(ListContext& out_list, const freya::FilePath& path) {
   assign_section_paths(out_list, "fonts", freya::ASSET_TYPE_FONT);
   assign_section_paths(out_list, "audio", freya::ASSET_TYPE_AUDIO_BUFFER);
   assign_section_paths(out_list, "lua", freya::ASSET_TYPE_LUA);
+  assign_section_paths(out_list, "particles", freya::ASSET_TYPE_PARTICLE_CONFIG);
+  assign_section_paths(out_list, "prefabs", freya::ASSET_TYPE_PREFAB);
 
   lua_pop(out_list.lua_state, 1);
 
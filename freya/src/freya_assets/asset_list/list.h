@@ -9,6 +9,11 @@ struct ListSection {
   freya::FilePath directory;
 
   freya::DynamicArray<freya::FilePath> assets;
+
+  // Texture-only settings
+
+  bool has_mipmaps   = true;
+  bool is_compressed = false;
 };
 /// ListSection
 /// ----------------------------------------------------------------------
@@ -3,6 +3,7 @@
 #include "freya_logger.h"
 #include "freya_memory.h"
 #include "freya_render.h"
+#include "freya_timer.h"
 
 #include "asset_list/list.h"
 #include "loaders/asset_loaders.h"
@@ -15,11 +16,32 @@
 
 namespace freya { // Start of freya
 
+/// ----------------------------------------------------------------------
+/// TextureUpload 
+struct TextureUpload {
+  AssetGroupID group_id;
+
+  sg_image image;
+  sg_view view;
+  sg_sampler sampler;
+  sg_image_desc image_desc;
+
+  void* levels[SG_MAX_MIPMAPS] = {};
+  sizei size                   = 0;
+};
+/// TextureUpload 
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// AssetManager 
 struct AssetManager {
   AssetGroupID cache_id;
   HashMap<i32, AssetGroup> groups;
+
+  DynamicArray<TextureUpload> uploads;
+
+  sizei upload_budget_bytes = ASSET_UPLOAD_BUDGET_BYTES;
+  f32 upload_budget_ms      = ASSET_UPLOAD_BUDGET_MS;
 };
 
 static AssetManager s_manager;
@@ -87,37 +109,118 @@ static bool can_build_frpkg(const FilePath& assets_path, const FilePath& output_
   return false;
 }
 
+static void free_texture_upload(TextureUpload& upload) {
+  for(auto& level : upload.levels) {
+    if(level) {
+      memory_free(level);
+    }
+  }
+}
+
+static void cancel_texture_upload(TextureUpload& upload) {
+  free_texture_upload(upload);
+
+  // The handles were only ever allocated, never initialized
+
+  sg_dealloc_view(upload.view);
+  sg_dealloc_image(upload.image);
+  sg_destroy_sampler(upload.sampler);
+}
+
+static AssetID queue_texture_upload(AssetGroup& group, 
+                                    const sg_image_desc& image_desc, 
+                                    const sg_sampler_desc& sampler_desc, 
+                                    void** levels) {
+  // Only allocate the handles for now. The actual data will 
+  // be uploaded later on in `asset_manager_update`.
+
+  Texture texture;
+
+  texture.id      = (i32)group.textures.size();
+  texture.size    = Vec2(image_desc.width, image_desc.height);
+  texture.image   = sg_alloc_image();
+  texture.view    = sg_alloc_view();
+  texture.sampler = sg_make_sampler(sampler_desc); 
+
+  // Queue the upload
+
+  TextureUpload upload = {
+    .group_id   = group.id,
+    .image      = texture.image, 
+    .view       = texture.view,
+    .sampler    = texture.sampler,
+    .image_desc = image_desc,
+  };
+
+  for(i32 i = 0; i < image_desc.num_mipmaps; i++) {
+    upload.levels[i] = levels[i];
+    upload.size     += image_desc.data.mip_levels[i].size;
+  }
+
+  s_manager.uploads.push_back(upload);
+
+  // Push the texture
+
+  AssetID id; 
+  PUSH_ASSET(group, textures, texture, ASSET_TYPE_TEXTURE, id);
+
+  // Done!
+  return id;
+}
+
 static void build_textures(File& file, const ListSection& section) {
   FREYA_PROFILE_FUNCTION();
 
   // Write the number of assets of this type
+  //
+  // @NOTE: Any textures that fail to load get skipped, so the 
+  // real count gets patched in once all the assets are written.
+
+  sizei count_pos = file_tell_write(file);
+  u16 asset_count = 0; 
 
-  u16 asset_count = (u16)section.assets.size(); 
   file_write_bytes(file, &asset_count, sizeof(asset_count));
 
   // Load and write all of the assets
 
   for(const auto& path : section.assets) {
-    // Write the name of the asset
-
-    FilePath name = filepath_stem(path);
-    file_write_bytes(file, name);
-
     // Load the asset
      
     sg_sampler_desc sampler_desc = {};
     sampler_desc.min_filter      = SG_FILTER_NEAREST;
     sampler_desc.mag_filter      = SG_FILTER_NEAREST;
+    sampler_desc.mipmap_filter   = section.has_mipmaps ? SG_FILTER_LINEAR : SG_FILTER_NEAREST;
 
     sg_image_desc image_desc = {};
     void* pixels             = nullptr;
 
-    texture_loader_load(path, image_desc, &pixels);
+    if(!texture_loader_load(path, image_desc, &pixels)) {
+      FREYA_LOG_ERROR("Skipping texture at \'%s\' in the frpkg", path.c_str());
+      continue;
+    }
+
+    // Generate the mip chain (or just the base level) and compress it if needed
+
+    DynamicArray<TextureMipLevel> levels;
+    texture_loader_generate_mipmaps(image_desc, pixels, levels);
+
+    if(!section.has_mipmaps) {
+      levels.resize(1);
+    }
+
+    if(section.is_compressed) {
+      image_desc.pixel_format = texture_loader_compress(image_desc.pixel_format, levels);
+    }
      
     // 
     // Write the asset 
     //
   
+    // Write the name of the asset
+
+    FilePath name = filepath_stem(path);
+    file_write_bytes(file, name);
+
     // Write the texture's size
 
     u16 width  = (u16)image_desc.width;
@@ -133,22 +236,38 @@ static void build_textures(File& file, const ListSection& section) {
 
     // Write the filters 
 
-    u8 min_filter = (u8)sampler_desc.min_filter;
-    u8 mag_filter = (u8)sampler_desc.mag_filter;
+    u8 min_filter    = (u8)sampler_desc.min_filter;
+    u8 mag_filter    = (u8)sampler_desc.mag_filter;
+    u8 mipmap_filter = (u8)sampler_desc.mipmap_filter;
 
     file_write_bytes(file, &min_filter, sizeof(min_filter));
     file_write_bytes(file, &mag_filter, sizeof(mag_filter));
+    file_write_bytes(file, &mipmap_filter, sizeof(mipmap_filter));
+
+    // Write the mip levels
 
-    // Write the data
+    u8 mips_count = (u8)levels.size();
+    file_write_bytes(file, &mips_count, sizeof(mips_count));
 
-    u32 pixel_size = (format == SG_PIXELFORMAT_RGBA16F) ? 4 : 1; 
-    u32 data_size  = (width * height) * 4 * pixel_size; // 4 = color components
+    for(auto& level : levels) {
+      u32 data_size = (u32)level.data.size();
 
-    file_write_bytes(file, pixels, data_size);
+      file_write_bytes(file, &data_size, sizeof(data_size));
+      file_write_bytes(file, level.data.data(), data_size);
+    }
 
     // Free the data
     memory_free(pixels); 
+    asset_count++;
   }
+
+  // Patch in the actual number of assets
+
+  sizei end_pos = file_tell_write(file);
+
+  file_seek_write(file, count_pos);
+  file_write_bytes(file, &asset_count, sizeof(asset_count));
+  file_seek_write(file, end_pos);
 }
 
 static void build_fonts(File& pkg_file, const ListSection& section) {
@@ -253,6 +372,173 @@ static void build_lua_state(File& pkg_file, const ListSection& section) {
   }
 }
 
+static void build_particle_configs(File& pkg_file, const ListSection& section) {
+  FREYA_PROFILE_FUNCTION();
+
+  // Write the number of assets of this type
+
+  u16 asset_count = (u16)section.assets.size(); 
+  file_write_bytes(pkg_file, &asset_count, sizeof(asset_count));
+  
+  // Evaluate and write all of the assets
+  
+  for(const auto& path : section.assets) {
+    // Write the name of the asset
+
+    FilePath name = filepath_stem(path);
+    file_write_bytes(pkg_file, name);
+
+    // Run the config once, here, so that the runtime never has to 
+
+    String src;
+    lua_state_loader_load(path, &src);
+
+    lua_State* lua = luaL_newstate();
+
+    luaopen_base(lua);
+    luaopen_table(lua);
+
+    ParticleEmitterDesc desc;
+    
+    if(luaL_dostring(lua, src.c_str()) != LUA_OK) {
+      FREYA_LOG_WARN("LUA-ERROR: %s", lua_tostring(lua, -1));
+      lua_pop(lua, 1);
+    }
+    else if(!particle_emitter_desc_load(desc, lua)) {
+      FREYA_LOG_WARN("Particle config at \'%s\' will use the default values", path.c_str());
+    }
+
+    lua_close(lua);
+
+    //
+    // Write the asset
+    //
+    // @NOTE: Textures and collision grids cannot be given through 
+    // the config, so they are never written.
+    //
+
+    // Write the spawning state
+
+    file_write_bytes(pkg_file, &desc.velocity, sizeof(desc.velocity));
+    file_write_bytes(pkg_file, &desc.count, sizeof(desc.count));
+    file_write_bytes(pkg_file, &desc.scale, sizeof(desc.scale));
+    file_write_bytes(pkg_file, &desc.bounds, sizeof(desc.bounds));
+
+    // Write the looks
+    
+    u8 is_aligned = (u8)desc.align_to_velocity;
+
+    file_write_bytes(pkg_file, &desc.color, sizeof(desc.color));
+    file_write_bytes(pkg_file, &desc.color_over_life, sizeof(desc.color_over_life));
+    file_write_bytes(pkg_file, &desc.scale_over_life, sizeof(desc.scale_over_life));
+    file_write_bytes(pkg_file, &is_aligned, sizeof(is_aligned));
+
+    // Write the lifetime
+
+    file_write_bytes(pkg_file, &desc.lifetime, sizeof(desc.lifetime));
+    file_write_bytes(pkg_file, &desc.lifetime_variance, sizeof(desc.lifetime_variance));
+    file_write_bytes(pkg_file, &desc.spawn_rate, sizeof(desc.spawn_rate));
+    file_write_bytes(pkg_file, &desc.gravity_factor, sizeof(desc.gravity_factor));
+
+    // Write the distribution
+    
+    u8 distribution = (u8)desc.distribution;
+
+    file_write_bytes(pkg_file, &distribution, sizeof(distribution));
+    file_write_bytes(pkg_file, &desc.distribution_radius, sizeof(desc.distribution_radius));
+    file_write_bytes(pkg_file, &desc.seed, sizeof(desc.seed));
+
+    // Write the collisions
+    
+    u8 collision = (u8)desc.collision;
+
+    file_write_bytes(pkg_file, &collision, sizeof(collision));
+    file_write_bytes(pkg_file, &desc.bounce, sizeof(desc.bounce));
+    file_write_bytes(pkg_file, &desc.friction, sizeof(desc.friction));
+  }
+}
+
+static void build_prefabs(File& pkg_file, const ListSection& section) {
+  FREYA_PROFILE_FUNCTION();
+
+  // Write the number of assets of this type
+
+  u16 asset_count = (u16)section.assets.size(); 
+  file_write_bytes(pkg_file, &asset_count, sizeof(asset_count));
+  
+  // Evaluate and write all of the assets
+  
+  for(const auto& path : section.assets) {
+    // Write the name of the asset
+
+    FilePath name = filepath_stem(path);
+    file_write_bytes(pkg_file, name);
+
+    // Run the file once, here, so that the runtime never has to 
+
+    String src;
+    lua_state_loader_load(path, &src);
+
+    lua_State* lua = luaL_newstate();
+
+    luaopen_base(lua);
+    luaopen_table(lua);
+
+    PrefabDesc desc;
+    
+    if(luaL_dostring(lua, src.c_str()) != LUA_OK) {
+      FREYA_LOG_WARN("LUA-ERROR: %s", lua_tostring(lua, -1));
+      lua_pop(lua, 1);
+    }
+    else if(!prefab_desc_load(desc, lua)) {
+      FREYA_LOG_WARN("Prefab at \'%s\' will use the default values", path.c_str());
+    }
+
+    lua_close(lua);
+
+    //
+    // Write the asset
+    //
+
+    // Write the transform
+    
+    file_write_bytes(pkg_file, &desc.scale, sizeof(desc.scale));
+    file_write_bytes(pkg_file, &desc.rotation, sizeof(desc.rotation));
+
+    // Write the tag and the sprite
+    
+    file_write_bytes(pkg_file, desc.tag);
+    file_write_bytes(pkg_file, desc.texture);
+    
+    file_write_bytes(pkg_file, &desc.color, sizeof(desc.color));
+    file_write_bytes(pkg_file, &desc.source, sizeof(desc.source));
+    file_write_bytes(pkg_file, &desc.layer, sizeof(desc.layer));
+
+    // Write the body
+    
+    u8 has_body  = (u8)desc.has_body;
+    u8 body_type = (u8)desc.body_type;
+    u8 is_fixed  = (u8)desc.rotation_fixed;
+
+    file_write_bytes(pkg_file, &has_body, sizeof(has_body));
+    file_write_bytes(pkg_file, &body_type, sizeof(body_type));
+    file_write_bytes(pkg_file, &is_fixed, sizeof(is_fixed));
+    
+    file_write_bytes(pkg_file, &desc.gravity_factor, sizeof(desc.gravity_factor));
+    file_write_bytes(pkg_file, &desc.linear_damping, sizeof(desc.linear_damping));
+
+    // Write the collider
+    
+    u8 is_sensor = (u8)desc.collider.is_sensor;
+    file_write_bytes(pkg_file, &is_sensor, sizeof(is_sensor));
+
+    file_write_bytes(pkg_file, &desc.collider.density, sizeof(desc.collider.density));
+    file_write_bytes(pkg_file, &desc.collider.friction, sizeof(desc.collider.friction));
+    file_write_bytes(pkg_file, &desc.collider.restitution, sizeof(desc.collider.restitution));
+    file_write_bytes(pkg_file, &desc.collider_extents, sizeof(desc.collider_extents));
+  }
+}
+
 static void read_textures(File& file, AssetGroup& group) {
   FREYA_PROFILE_FUNCTION();
   
@@ -294,31 +580,66 @@ static void read_textures(File& file, AssetGroup& group) {
 
     // Read the filters
 
-    u8 min_filter, mag_filter;
+    u8 min_filter, mag_filter, mipmap_filter;
 
     file_read_bytes(file, &min_filter, sizeof(min_filter));
     file_read_bytes(file, &mag_filter, sizeof(mag_filter));
+    file_read_bytes(file, &mipmap_filter, sizeof(mipmap_filter));
+
+    sampler_desc.min_filter    = (sg_filter)min_filter;
+    sampler_desc.mag_filter    = (sg_filter)mag_filter;
+    sampler_desc.mipmap_filter = (sg_filter)mipmap_filter;
+
+    // Read the mip levels
+
+    u8 mips_count;
+    file_read_bytes(file, &mips_count, sizeof(mips_count));
+
+    // A corrupted (or hand-made) package could have any count here,
+    // which would run right past the levels below.
 
-    sampler_desc.min_filter = (sg_filter)min_filter;
-    sampler_desc.mag_filter = (sg_filter)mag_filter;
+    if(mips_count == 0 || mips_count > SG_MAX_MIPMAPS) {
+      FREYA_LOG_ERROR("Texture \'%s\' has an invalid amount of mip levels (%i). Try rebuilding the frpkg", name.c_str(), (i32)mips_count);
 
-    // Read the data
+      // Skip the levels, so the rest of the assets can still be read
 
-    u32 pixel_size = (format == SG_PIXELFORMAT_RGBA16F) ? 4 : 1; 
-    u32 data_size  = (width * height) * 4 * pixel_size; // 4 = color components
+      for(u8 mip = 0; mip < mips_count; mip++) {
+        u32 data_size;
+        file_read_bytes(file, &data_size, sizeof(data_size));
 
-    void* pixels = memory_allocate(data_size);
-    file_read_bytes(file, pixels, data_size);
+        file_seek_read(file, file_tell_read(file) + data_size);
+      }
+
+      continue;
+    }
+
+    image_desc.num_mipmaps = mips_count;
+
+    void* levels[SG_MAX_MIPMAPS] = {};
+    for(u8 mip = 0; mip < mips_count; mip++) {
+      u32 data_size;
+      file_read_bytes(file, &data_size, sizeof(data_size));
+
+      levels[mip] = memory_allocate(data_size);
+      file_read_bytes(file, levels[mip], data_size);
     
-    image_desc.data.mip_levels[0].ptr  = pixels;
-    image_desc.data.mip_levels[0].size = data_size;
+      image_desc.data.mip_levels[mip].ptr  = levels[mip];
+      image_desc.data.mip_levels[mip].size = data_size;
+    }
+
+    // A package built with compressed textures might end up on a 
+    // platform that does not support them. 
+
+    if(!sg_query_pixelformat(image_desc.pixel_format).sample) {
+      FREYA_LOG_ERROR("Texture \'%s\' uses a pixel format that is not supported on this platform. Rebuild the frpkg without compression", name.c_str());
+    }
 
-    // Add the texture to the group
-    group.named_ids[name] = asset_group_push_texture(group.id, image_desc, sampler_desc); 
+    // Add the texture to the group, and let it stream in later. 
+    // The upload now owns the data of the levels.
+    group.named_ids[name] = queue_texture_upload(group, image_desc, sampler_desc, levels); 
     
     // Done!
-    
-    memory_free(pixels);
+
     FREYA_LOG_DEBUG("Loaded texture \'%s\' from frpkg ", name.c_str());
   }
 }
@@ -444,6 +765,145 @@ static void read_lua_state(File& file, AssetGroup& group) {
   }
 }
 
+static void read_particle_configs(File& file, AssetGroup& group) {
+  FREYA_PROFILE_FUNCTION();
+  
+  // Read the count
+
+  u16 count;
+  file_read_bytes(file, &count, sizeof(count));
+
+  // Read the asset
+
+  for(u16 i = 0; i < count; i++) {
+    // Read the name
+
+    String name;
+    file_read_bytes(file, &name);
+
+    ParticleEmitterDesc desc;
+
+    // Read the spawning state
+
+    file_read_bytes(file, &desc.velocity, sizeof(desc.velocity));
+    file_read_bytes(file, &desc.count, sizeof(desc.count));
+    file_read_bytes(file, &desc.scale, sizeof(desc.scale));
+    file_read_bytes(file, &desc.bounds, sizeof(desc.bounds));
+
+    // Read the looks
+    
+    u8 is_aligned;
+
+    file_read_bytes(file, &desc.color, sizeof(desc.color));
+    file_read_bytes(file, &desc.color_over_life, sizeof(desc.color_over_life));
+    file_read_bytes(file, &desc.scale_over_life, sizeof(desc.scale_over_life));
+    file_read_bytes(file, &is_aligned, sizeof(is_aligned));
+
+    desc.align_to_velocity = (bool)is_aligned;
+
+    // Read the lifetime
+
+    file_read_bytes(file, &desc.lifetime, sizeof(desc.lifetime));
+    file_read_bytes(file, &desc.lifetime_variance, sizeof(desc.lifetime_variance));
+    file_read_bytes(file, &desc.spawn_rate, sizeof(desc.spawn_rate));
+    file_read_bytes(file, &desc.gravity_factor, sizeof(desc.gravity_factor));
+
+    // Read the distribution
+    
+    u8 distribution;
+
+    file_read_bytes(file, &distribution, sizeof(distribution));
+    file_read_bytes(file, &desc.distribution_radius, sizeof(desc.distribution_radius));
+    file_read_bytes(file, &desc.seed, sizeof(desc.seed));
+
+    desc.distribution = (ParticleDistributionType)distribution;
+
+    // Read the collisions
+    
+    u8 collision;
+
+    file_read_bytes(file, &collision, sizeof(collision));
+    file_read_bytes(file, &desc.bounce, sizeof(desc.bounce));
+    file_read_bytes(file, &desc.friction, sizeof(desc.friction));
+
+    desc.collision = (ParticleCollisionType)collision;
+
+    // @NOTE: Grids only live at runtime. Whoever uses this 
+    // config has to give it their own grid, if any.
+    desc.collision_grid = nullptr;
+
+    // Add the config to the group
+    group.named_ids[name] = asset_group_push_particle_config(group.id, desc); 
+
+    FREYA_LOG_DEBUG("Loaded particle config \'%s\' from frpkg ", name.c_str());
+  }
+}
+
+static void read_prefabs(File& file, AssetGroup& group) {
+  FREYA_PROFILE_FUNCTION();
+  
+  // Read the count
+
+  u16 count;
+  file_read_bytes(file, &count, sizeof(count));
+
+  // Read the asset
+
+  for(u16 i = 0; i < count; i++) {
+    // Read the name
+
+    String name;
+    file_read_bytes(file, &name);
+
+    PrefabDesc desc;
+
+    // Read the transform
+    
+    file_read_bytes(file, &desc.scale, sizeof(desc.scale));
+    file_read_bytes(file, &desc.rotation, sizeof(desc.rotation));
+
+    // Read the tag and the sprite
+    
+    file_read_bytes(file, &desc.tag);
+    file_read_bytes(file, &desc.texture);
+    
+    file_read_bytes(file, &desc.color, sizeof(desc.color));
+    file_read_bytes(file, &desc.source, sizeof(desc.source));
+    file_read_bytes(file, &desc.layer, sizeof(desc.layer));
+
+    // Read the body
+    
+    u8 has_body, body_type, is_fixed;
+
+    file_read_bytes(file, &has_body, sizeof(has_body));
+    file_read_bytes(file, &body_type, sizeof(body_type));
+    file_read_bytes(file, &is_fixed, sizeof(is_fixed));
+
+    desc.has_body       = (bool)has_body;
+    desc.body_type      = (PhysicsBodyType)body_type;
+    desc.rotation_fixed = (bool)is_fixed;
+    
+    file_read_bytes(file, &desc.gravity_factor, sizeof(desc.gravity_factor));
+    file_read_bytes(file, &desc.linear_damping, sizeof(desc.linear_damping));
+
+    // Read the collider
+    
+    u8 is_sensor;
+    file_read_bytes(file, &is_sensor, sizeof(is_sensor));
+    desc.collider.is_sensor = (bool)is_sensor;
+
+    file_read_bytes(file, &desc.collider.density, sizeof(desc.collider.density));
+    file_read_bytes(file, &desc.collider.friction, sizeof(desc.collider.friction));
+    file_read_bytes(file, &desc.collider.restitution, sizeof(desc.collider.restitution));
+    file_read_bytes(file, &desc.collider_extents, sizeof(desc.collider_extents));
+
+    // Add the prefab to the group
+    group.named_ids[name] = asset_group_push_prefab(group.id, desc); 
+
+    FREYA_LOG_DEBUG("Loaded prefab \'%s\' from frpkg ", name.c_str());
+  }
+}
+
 static bool build_package(const FilePath& list_path, const FilePath& output_path) {
   // Load the frlist file
 
@@ -499,6 +959,12 @@ static bool build_package(const FilePath& list_path, const FilePath& output_path
       case ASSET_TYPE_LUA:
         build_lua_state(pkg_file, section);
         break;
+      case ASSET_TYPE_PARTICLE_CONFIG:
+        build_particle_configs(pkg_file, section);
+        break;
+      case ASSET_TYPE_PREFAB:
+        build_prefabs(pkg_file, section);
+        break;
       default:
         break;
     }
@@ -534,6 +1000,13 @@ void asset_manager_init() {
 }
 
 void asset_manager_shutdown() {
+  // Drop any uploads that never made it 
+
+  for(auto& upload : s_manager.uploads) {
+    cancel_texture_upload(upload);
+  }
+  s_manager.uploads.clear();
+
   // Shutdown the cache asset group
   asset_group_destroy(s_manager.cache_id); 
 
@@ -545,6 +1018,66 @@ AssetGroup& asset_manager_get_group(const AssetGroupID& group_id) {
   return s_manager.groups[group_id.get_id()];
 }
 
+void asset_manager_update() {
+  if(s_manager.uploads.empty()) {
+    return;
+  }
+
+  FREYA_PROFILE_FUNCTION();
+
+  PerfTimer timer;
+  perf_timer_start(timer);
+
+  // Upload as many textures as the budget allows
+
+  sizei uploaded_bytes = 0;
+  sizei uploads_count  = 0;
+
+  for(auto& upload : s_manager.uploads) {
+    // Always make _some_ progress, even if a single texture is over the budget
+
+    if(uploads_count > 0) {
+      perf_timer_stop(timer);
+
+      bool over_bytes = (uploaded_bytes + upload.size) > s_manager.upload_budget_bytes;
+      bool over_time  = timer.to_milliseconds >= s_manager.upload_budget_ms;
+
+      if(over_bytes || over_time) {
+        break;
+      }
+    }
+
+    // Upload the image and only then create its view
+
+    sg_init_image(upload.image, upload.image_desc);
+
+    sg_view_desc view_desc  = {};
+    view_desc.texture.image = upload.image; 
+    sg_init_view(upload.view, view_desc);
+
+    // Done!
+
+    free_texture_upload(upload);
+
+    uploaded_bytes += upload.size;
+    uploads_count++;
+  }
+
+  s_manager.uploads.erase(s_manager.uploads.begin(), s_manager.uploads.begin() + uploads_count);
+
+  // The new textures need to be seen
+  renderer_request_redraw();
+}
+
+void asset_manager_set_upload_budget(const sizei max_bytes, const f32 max_milliseconds) {
+  s_manager.upload_budget_bytes = max_bytes;
+  s_manager.upload_budget_ms    = max_milliseconds;
+}
+
+const u32 asset_manager_get_pending_uploads() {
+  return (u32)s_manager.uploads.size();
+}
+
 /// Asset manager functions
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -583,6 +1116,19 @@ void asset_group_clear(const AssetGroupID& group_id) {
   // Destroy GFX assets
   //
 
+  // Any textures that were not uploaded yet will never be
+
+  for(sizei i = 0; i < s_manager.uploads.size();) {
+    TextureUpload& upload = s_manager.uploads[i];
+    if(upload.group_id != group_id.get_id()) {
+      i++;
+      continue;
+    }
+
+    cancel_texture_upload(upload);
+    s_manager.uploads.erase(s_manager.uploads.begin() + i);
+  }
+
   group.buffers.clear();
   group.textures.clear();
   group.shaders.clear();
@@ -596,6 +1142,16 @@ void asset_group_clear(const AssetGroupID& group_id) {
   }
   group.lua_states.clear();
 
+  for(auto& asset : group.particle_configs) {
+    delete asset;
+  }
+  group.particle_configs.clear();
+
+  for(auto& asset : group.prefabs) {
+    delete asset;
+  }
+  group.prefabs.clear();
+
   for(auto& asset : group.audio_buffers) {
     audio_buffer_destroy(asset);
   }
@@ -652,6 +1208,8 @@ bool asset_group_build(const AssetGroupID& group_id,
     "fonts",
     "audio", 
     "lua",
+    "particles",
+    "prefabs",
   };
 
   for(sizei i = 0; i < group.watchers.size(); i++) {
@@ -872,6 +1430,43 @@ AssetID asset_group_push_lua_state(const AssetGroupID& group_id, const String& l
   return id;
 }
 
+AssetID asset_group_push_particle_config(const AssetGroupID& group_id, const ParticleEmitterDesc& desc) {
+  GROUP_CHECK(group_id);
+  AssetGroup& group = s_manager.groups[group_id.get_id()];
+
+  // New config added!
+
+  AssetID id;
+  PUSH_ASSET(group, particle_configs, new ParticleEmitterDesc(desc), ASSET_TYPE_PARTICLE_CONFIG, id);
+
+  // Some useful debug info
+  
+  FREYA_LOG_DEBUG("Group \'%s\' pushed a new particle config:", group.name.c_str());
+  FREYA_LOG_DEBUG("     Count = %i", desc.count);
+
+  // Done!
+  return id;
+}
+
+AssetID asset_group_push_prefab(const AssetGroupID& group_id, const PrefabDesc& desc) {
+  GROUP_CHECK(group_id);
+  AssetGroup& group = s_manager.groups[group_id.get_id()];
+
+  // New prefab added!
+
+  AssetID id;
+  PUSH_ASSET(group, prefabs, new PrefabDesc(desc), ASSET_TYPE_PREFAB, id);
+
+  // Some useful debug info
+  
+  FREYA_LOG_DEBUG("Group \'%s\' pushed a new prefab:", group.name.c_str());
+  FREYA_LOG_DEBUG("     Tag     = %s", desc.tag.c_str());
+  FREYA_LOG_DEBUG("     Texture = %s", desc.texture.c_str());
+
+  // Done!
+  return id;
+}
+
 bool asset_group_load_package(const AssetGroupID& group_id, const FilePath& frpkg_path) {
   GROUP_CHECK(group_id);
   AssetGroup& group = s_manager.groups[group_id.get_id()];
@@ -933,6 +1528,12 @@ bool asset_group_load_package(const AssetGroupID& group_id, const FilePath& frpk
       case ASSET_TYPE_LUA:
         read_lua_state(file, group);
         break;
+      case ASSET_TYPE_PARTICLE_CONFIG:
+        read_particle_configs(file, group);
+        break;
+      case ASSET_TYPE_PREFAB:
+        read_prefabs(file, group);
+        break;
       default:
         break;
     }
@@ -952,6 +1553,16 @@ bool asset_group_load_package(const AssetGroupID& group_id, const FilePath& frpk
   return true;
 }
 
+const bool asset_group_is_streaming(const AssetGroupID& group_id) {
+  for(auto& upload : s_manager.uploads) {
+    if(upload.group_id == group_id.get_id()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 const AssetID& asset_group_get_id(const AssetGroupID& group_id, const String& asset_name) {
   GROUP_CHECK(group_id);
   AssetGroup& group = s_manager.groups[group_id.get_id()];
@@ -967,6 +1578,19 @@ const AssetID& asset_group_get_id(const AssetGroupID& group_id, const String& as
   return group.named_ids[asset_name];
 }
 
+String asset_group_get_name(const AssetID& id) {
+  AssetGroup& group = s_manager.groups[id.get_group_id()];
+
+  for(auto& [name, asset_id] : group.named_ids) {
+    if(asset_id.get_type() == id.get_type() && asset_id.get_id() == id.get_id()) {
+      return name;
+    }
+  }
+
+  // This asset was never named
+  return "";
+}
+
 sg_buffer asset_group_get_buffer(const AssetID& id) {
   AssetGroup& group = s_manager.groups[id.get_group_id()];
   return get_asset(id, group.buffers, ASSET_TYPE_BUFFER);
@@ -997,6 +1621,16 @@ lua_State* asset_group_get_lua_state(const AssetID& id) {
   return get_asset(id, group.lua_states, ASSET_TYPE_LUA);
 }
 
+ParticleEmitterDesc* asset_group_get_particle_config(const AssetID& id) {
+  AssetGroup& group = s_manager.groups[id.get_group_id()];
+  return get_asset(id, group.particle_configs, ASSET_TYPE_PARTICLE_CONFIG);
+}
+
+PrefabDesc* asset_group_get_prefab(const AssetID& id) {
+  AssetGroup& group = s_manager.groups[id.get_group_id()];
+  return get_asset(id, group.prefabs, ASSET_TYPE_PREFAB);
+}
+
 /// AssetGroupID functions
 /// ----------------------------------------------------------------------
 
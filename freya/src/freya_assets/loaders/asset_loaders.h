@@ -2,11 +2,24 @@
 
 #include "freya_assets.h"
 
+/// ----------------------------------------------------------------------
+/// TextureMipLevel
+struct TextureMipLevel {
+  freya::i32 width, height;
+  freya::DynamicArray<freya::u8> data;
+};
+/// TextureMipLevel
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// Texture loader functions
 
 bool texture_loader_load(const freya::FilePath& path, sg_image_desc& out_img, void** out_data);
 
+void texture_loader_generate_mipmaps(const sg_image_desc& img_desc, const void* pixels, freya::DynamicArray<TextureMipLevel>& out_levels);
+
+sg_pixel_format texture_loader_compress(const sg_pixel_format format, freya::DynamicArray<TextureMipLevel>& levels);
+
 /// Texture loader functions
 /// ----------------------------------------------------------------------
 
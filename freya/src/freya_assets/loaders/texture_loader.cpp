@@ -5,6 +5,9 @@
 
 #include <stb/stb_image.h>
 
+#include <cstring>
+#include <type_traits>
+
 /// ----------------------------------------------------------------------
 /// Private functions
 
@@ -22,6 +25,223 @@ static bool check_valid_extension(const freya::FilePath& ext) {
          ext == ".pgm";
 }
 
+static freya::sizei get_pixel_size(const sg_pixel_format format) {
+  return (format == SG_PIXELFORMAT_RGBA32F) ? (4 * sizeof(freya::f32)) : 4;
+}
+
+template<typename T> 
+static void downsample_level(const TextureMipLevel& src, TextureMipLevel& dest) {
+  const T* src_pixels = (const T*)src.data.data();
+  T* dest_pixels      = (T*)dest.data.data();
+
+  // A 2x2 box filter, with the colors weighted by their alpha 
+  // to avoid any dark fringes around transparent edges. 
+
+  for(freya::i32 y = 0; y < dest.height; y++) {
+    for(freya::i32 x = 0; x < dest.width; x++) {
+      freya::i32 x0 = glm::min(x * 2, src.width - 1);
+      freya::i32 y0 = glm::min(y * 2, src.height - 1);
+      freya::i32 x1 = glm::min(x0 + 1, src.width - 1);
+      freya::i32 y1 = glm::min(y0 + 1, src.height - 1);
+
+      const T* samples[4] = {
+        &src_pixels[(y0 * src.width + x0) * 4],
+        &src_pixels[(y0 * src.width + x1) * 4],
+        &src_pixels[(y1 * src.width + x0) * 4],
+        &src_pixels[(y1 * src.width + x1) * 4],
+      };
+
+      freya::f32 color[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+      for(auto& sample : samples) {
+        freya::f32 alpha = (freya::f32)sample[3];
+
+        color[0] += (freya::f32)sample[0] * alpha;
+        color[1] += (freya::f32)sample[1] * alpha;
+        color[2] += (freya::f32)sample[2] * alpha;
+        color[3] += alpha;
+      }
+
+      T* out = &dest_pixels[(y * dest.width + x) * 4];
+      for(freya::i32 i = 0; i < 3; i++) {
+        freya::f32 value = (color[3] > 0.0f) ? (color[i] / color[3]) : 0.0f;
+        out[i]           = (T)(std::is_integral<T>::value ? (value + 0.5f) : value);
+      }
+      
+      freya::f32 alpha = color[3] / 4.0f;
+      out[3]           = (T)(std::is_integral<T>::value ? (alpha + 0.5f) : alpha);
+    }
+  }
+}
+
+static freya::u16 pack_565(const freya::u8* color) {
+  return (freya::u16)(((color[0] >> 3) << 11) | ((color[1] >> 2) << 5) | (color[2] >> 3));
+}
+
+static void unpack_565(const freya::u16 packed, freya::i32* out_color) {
+  freya::i32 r = (packed >> 11) & 31;
+  freya::i32 g = (packed >> 5) & 63;
+  freya::i32 b = packed & 31;
+
+  out_color[0] = (r << 3) | (r >> 2);
+  out_color[1] = (g << 2) | (g >> 4);
+  out_color[2] = (b << 3) | (b >> 2);
+}
+
+static void encode_color_block(const freya::u8 block[16][4], freya::u8* out) {
+  // Find the endpoints using the (slightly inset) bounding box of the block
+
+  freya::u8 min_color[3] = {255, 255, 255};
+  freya::u8 max_color[3] = {0, 0, 0};
+
+  for(freya::i32 i = 0; i < 16; i++) {
+    for(freya::i32 c = 0; c < 3; c++) {
+      min_color[c] = glm::min(min_color[c], block[i][c]);
+      max_color[c] = glm::max(max_color[c], block[i][c]);
+    }
+  }
+
+  for(freya::i32 c = 0; c < 3; c++) {
+    freya::i32 inset = (max_color[c] - min_color[c]) >> 4;
+
+    min_color[c] = (freya::u8)glm::min(min_color[c] + inset, 255);
+    max_color[c] = (freya::u8)glm::max(max_color[c] - inset, 0);
+  }
+
+  freya::u16 color0 = pack_565(max_color);
+  freya::u16 color1 = pack_565(min_color);
+
+  // The endpoints have to be in the 4-color order (color0 > color1)
+  
+  if(color0 < color1) {
+    freya::u16 temp = color0; 
+    color0          = color1; 
+    color1          = temp;
+  }
+
+  // Build the palette
+  
+  freya::i32 palette[4][3];
+  unpack_565(color0, palette[0]);
+  unpack_565(color1, palette[1]);
+
+  for(freya::i32 c = 0; c < 3; c++) {
+    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+  }
+
+  // Pick the closest palette entry for each pixel
+
+  freya::u32 indices = 0;
+  if(color0 != color1) {
+    for(freya::i32 i = 0; i < 16; i++) {
+      freya::i32 best_index    = 0; 
+      freya::i32 best_distance = INT32_MAX;
+
+      for(freya::i32 p = 0; p < 4; p++) {
+        freya::i32 dr = block[i][0] - palette[p][0];
+        freya::i32 dg = block[i][1] - palette[p][1];
+        freya::i32 db = block[i][2] - palette[p][2];
+
+        freya::i32 distance = (dr * dr) + (dg * dg) + (db * db);
+        if(distance < best_distance) {
+          best_distance = distance;
+          best_index    = p;
+        }
+      }
+
+      indices |= (freya::u32)best_index << (i * 2);
+    }
+  }
+
+  // Done!
+
+  memcpy(out + 0, &color0, sizeof(color0));
+  memcpy(out + 2, &color1, sizeof(color1));
+  memcpy(out + 4, &indices, sizeof(indices));
+}
+
+static void encode_alpha_block(const freya::u8 block[16][4], freya::u8* out) {
+  // Find the endpoints
+
+  freya::u8 alpha0 = 0; 
+  freya::u8 alpha1 = 255;
+
+  for(freya::i32 i = 0; i < 16; i++) {
+    alpha0 = glm::max(alpha0, block[i][3]);
+    alpha1 = glm::min(alpha1, block[i][3]);
+  }
+
+  // Build the 8-value palette (alpha0 > alpha1)
+
+  freya::i32 palette[8] = {alpha0, alpha1};
+  for(freya::i32 p = 1; p < 7; p++) {
+    palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+  }
+  
+  // Pick the closest palette entry for each pixel
+
+  freya::u64 indices = 0;
+  if(alpha0 != alpha1) {
+    for(freya::i32 i = 0; i < 16; i++) {
+      freya::i32 best_index    = 0; 
+      freya::i32 best_distance = INT32_MAX;
+
+      for(freya::i32 p = 0; p < 8; p++) {
+        freya::i32 distance = glm::abs(block[i][3] - palette[p]);
+        if(distance < best_distance) {
+          best_distance = distance;
+          best_index    = p;
+        }
+      }
+
+      indices |= (freya::u64)best_index << (i * 3);
+    }
+  }
+
+  // Done!
+
+  out[0] = alpha0; 
+  out[1] = alpha1;
+  memcpy(out + 2, &indices, 6); // Only the lower 48 bits are used
+}
+
+static void compress_level(TextureMipLevel& level, const bool has_alpha) {
+  freya::sizei block_size = has_alpha ? 16 : 8;
+  freya::i32 blocks_x     = (level.width + 3) / 4;
+  freya::i32 blocks_y     = (level.height + 3) / 4;
+  
+  freya::DynamicArray<freya::u8> compressed(blocks_x * blocks_y * block_size);
+  freya::u8* out = compressed.data();
+
+  for(freya::i32 by = 0; by < blocks_y; by++) {
+    for(freya::i32 bx = 0; bx < blocks_x; bx++) {
+      // Gather the 4x4 block, clamping at the edges of the level
+
+      freya::u8 block[16][4];
+      for(freya::i32 y = 0; y < 4; y++) {
+        for(freya::i32 x = 0; x < 4; x++) {
+          freya::i32 px = glm::min(bx * 4 + x, level.width - 1);
+          freya::i32 py = glm::min(by * 4 + y, level.height - 1);
+
+          memcpy(block[y * 4 + x], &level.data[(py * level.width + px) * 4], 4);
+        }
+      }
+
+      // BC3 = alpha block + color block, and BC1 = color block
+
+      if(has_alpha) {
+        encode_alpha_block(block, out);
+        out += 8;
+      }
+
+      encode_color_block(block, out);
+      out += 8;
+    }
+  }
+
+  level.data = std::move(compressed);
+}
+
 /// Private functions
 /// ----------------------------------------------------------------------
 
@@ -68,5 +288,91 @@ bool texture_loader_load(const freya::FilePath& path, sg_image_desc& out_img, vo
   return true;
 }
 
+void texture_loader_generate_mipmaps(const sg_image_desc& img_desc, const void* pixels, freya::DynamicArray<TextureMipLevel>& out_levels) {
+  out_levels.clear();
+
+  // Nothing to work with
+
+  if(!pixels || img_desc.width <= 0 || img_desc.height <= 0) {
+    FREYA_LOG_WARN("Cannot generate mipmaps for an empty texture");
+    return;
+  }
+
+  freya::sizei pixel_size = get_pixel_size(img_desc.pixel_format);
+
+  // The first level is just the original image
+
+  TextureMipLevel base = {
+    .width  = img_desc.width, 
+    .height = img_desc.height,
+  };
+
+  base.data.resize(base.width * base.height * pixel_size);
+  memcpy(base.data.data(), pixels, base.data.size());
+
+  out_levels.push_back(std::move(base));
+
+  // Keep halving the previous level until we hit 1x1
+
+  while(out_levels.size() < SG_MAX_MIPMAPS) {
+    const TextureMipLevel& prev = out_levels.back();
+    if(prev.width == 1 && prev.height == 1) {
+      break;
+    }
+
+    TextureMipLevel level = {
+      .width  = glm::max(prev.width / 2, 1), 
+      .height = glm::max(prev.height / 2, 1),
+    };
+    level.data.resize(level.width * level.height * pixel_size);
+
+    if(img_desc.pixel_format == SG_PIXELFORMAT_RGBA32F) {
+      downsample_level<freya::f32>(prev, level);
+    }
+    else {
+      downsample_level<freya::u8>(prev, level);
+    }
+
+    out_levels.push_back(std::move(level));
+  }
+}
+
+sg_pixel_format texture_loader_compress(const sg_pixel_format format, freya::DynamicArray<TextureMipLevel>& levels) {
+  // Only 8-bit textures can be block-compressed
+
+  if(format != SG_PIXELFORMAT_RGBA8 || levels.empty()) {
+    return format;
+  }
+
+  // Fully opaque textures can get away with BC1, which is half the size of BC3
+
+  bool has_alpha              = false;
+  const TextureMipLevel& base = levels[0];
+
+  for(freya::sizei i = 3; i < base.data.size(); i += 4) {
+    if(base.data[i] != 255) {
+      has_alpha = true;
+      break;
+    }
+  }
+
+  sg_pixel_format compressed_format = has_alpha ? SG_PIXELFORMAT_BC3_RGBA : SG_PIXELFORMAT_BC1_RGBA;
+
+  // Make sure the current backend can actually sample the compressed format
+
+  if(!sg_isvalid() || !sg_query_pixelformat(compressed_format).sample) {
+    FREYA_LOG_WARN("Block-compressed textures are not supported on this platform. Falling back to uncompressed textures");
+    return format;
+  }
+
+  // Compress!
+
+  for(auto& level : levels) {
+    compress_level(level, has_alpha);
+  }
+
+  return compressed_format;
+}
+
 /// Texture loader functions
 /// ----------------------------------------------------------------------
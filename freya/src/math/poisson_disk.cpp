@@ -92,6 +92,15 @@ void poisson_disk_calculate(const PoissonDiskDesc& desc, DynamicArray<Vec2>& out
     }
   }
 
+  // Random generator init (a seeded one can be replayed)
+
+  Rng seeded_rng;
+  if(desc.seed != 0) {
+    rng_seed(seeded_rng, desc.seed);
+  }
+
+  Rng& rng = (desc.seed != 0) ? seeded_rng : rng_get_default();
+
   // Set up the arrays
 
   out_points.clear();
@@ -103,7 +112,7 @@ void poisson_disk_calculate(const PoissonDiskDesc& desc, DynamicArray<Vec2>& out
 
   disk.active_points.push_back(desc.start_point);
   while(disk.active_points.size() > 0) {
-    i32 random_index = random_i32(0, disk.active_points.size() - 1);
+    i32 random_index = random_i32(rng, 0, (i32)disk.active_points.size() - 1);
     Vec2 point       = disk.active_points[random_index];
 
     // Iterate through _k_ number of samples, until we either a) find a valid point, or 
@@ -111,12 +120,11 @@ void poisson_disk_calculate(const PoissonDiskDesc& desc, DynamicArray<Vec2>& out
 
     bool found = false;
     for(i32 i = 0; i < desc.num_iterations; i++) {
-      f32 random_angle = random_f32(0.0f, 1.0f) * freya::PI * 2;
-      Vec2 angle_dir   = Vec2(freya::cos(random_angle), freya::sin(random_angle));
+      Vec2 angle_dir = random_on_circle(rng);
 
       // Make sure that the candidate is actually valid
 
-      Vec2 candidate = point + angle_dir * random_f32(desc.radius, desc.radius * 2.0f);
+      Vec2 candidate = point + angle_dir * random_f32(rng, desc.radius, desc.radius * 2.0f);
       if(!point_is_valid(disk, out_points, candidate)) {
         continue;
       }
@@ -1,5 +1,7 @@
 #include "freya_math.h"
 
+#include <climits>
+
 //////////////////////////////////////////////////////////////////////////
 
 namespace freya { // Start of freya
@@ -7,73 +9,210 @@ namespace freya { // Start of freya
 /// ----------------------------------------------------------------------
 /// Globals
 
-static std::random_device rand_device;
-static std::mt19937 engine(rand_device());
+// @NOTE: Each thread gets its own default generator, seeded on first use.
+
+static thread_local Rng s_default_rng;
+static thread_local bool s_has_default_rng = false;
 
 /// Globals
 /// ----------------------------------------------------------------------
 
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static u64 splitmix64(u64& state) {
+  u64 value = (state += 0x9e3779b97f4a7c15ull);
+
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+
+  return value ^ (value >> 31);
+}
+
+static inline u64 rotate_left(const u64 value, const i32 shift) {
+  return (value << shift) | (value >> (64 - shift));
+}
+
+static inline f32 to_unit_f32(const u64 value) {
+  // The top 24 bits fill the mantissa exactly, giving [0, 1)
+  return (f32)(value >> 40) * (1.0f / 16777216.0f);
+}
+
+static inline f64 to_unit_f64(const u64 value) {
+  // The top 53 bits fill the mantissa exactly, giving [0, 1)
+  return (f64)(value >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// Math random functions
 
+void rng_seed(Rng& rng, const u64 seed) {
+  // Spread the seed over the whole state, so that
+  // even small (or zero) seeds give a good start.
+
+  u64 state = seed;
+  for(auto& value : rng.state) {
+    value = splitmix64(state);
+  }
+}
+
+Rng& rng_get_default() {
+  if(!s_has_default_rng) {
+    std::random_device device;
+
+    u64 seed = ((u64)device() << 32) | (u64)device();
+    seed    ^= (u64)std::hash<std::thread::id>{}(std::this_thread::get_id());
+
+    rng_seed(s_default_rng, seed);
+    s_has_default_rng = true;
+  }
+
+  return s_default_rng;
+}
+
+void random_seed(const u64 seed) {
+  rng_seed(s_default_rng, seed);
+  s_has_default_rng = true;
+}
+
+const u64 random_u64(Rng& rng) {
+  // xoshiro256++
+
+  u64* s     = rng.state;
+  u64 result = rotate_left(s[0] + s[3], 23) + s[0];
+  u64 temp   = s[1] << 17;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+
+  s[2] ^= temp;
+  s[3]  = rotate_left(s[3], 45);
+
+  return result;
+}
+
+const u64 random_u64(Rng& rng, const u64 min, const u64 max) {
+  u64 range = (max - min) + 1;
+  if(range == 0) { // The whole range of a u64
+    return random_u64(rng);
+  }
+
+  // Reject the few values that would make the modulo biased
+
+  u64 threshold = (0 - range) % range;
+  u64 value     = random_u64(rng);
+
+  while(value < threshold) {
+    value = random_u64(rng);
+  }
+
+  return min + (value % range);
+}
+
+const u32 random_u32(Rng& rng) {
+  return (u32)(random_u64(rng) >> 32);
+}
+
+const u32 random_u32(Rng& rng, const u32 min, const u32 max) {
+  return (u32)random_u64(rng, min, max);
+}
+
+const i32 random_i32(Rng& rng, const i32 min, const i32 max) {
+  u64 range = (u64)((i64)max - (i64)min);
+  return (i32)((i64)min + (i64)random_u64(rng, 0, range));
+}
+
+const f32 random_f32(Rng& rng) {
+  return to_unit_f32(random_u64(rng));
+}
+
+const f32 random_f32(Rng& rng, const f32 min, const f32 max) {
+  return min + ((max - min) * to_unit_f32(random_u64(rng)));
+}
+
+const f64 random_f64(Rng& rng) {
+  return to_unit_f64(random_u64(rng));
+}
+
+void random_fill_f32(Rng& rng, f32* out, const sizei count, const f32 min, const f32 max) {
+  f32 range = max - min;
+
+  for(sizei i = 0; i < count; i++) {
+    out[i] = min + (range * to_unit_f32(random_u64(rng)));
+  }
+}
+
+const Vec2 random_on_circle(Rng& rng) {
+  f32 angle = random_f32(rng, 0.0f, 2.0f * PI);
+  return Vec2(freya::cos(angle), freya::sin(angle));
+}
+
+const Vec2 random_in_disc(Rng& rng, const f32 radius) {
+  // @NOTE: The square root keeps the points from clumping up around the center.
+
+  f32 angle    = random_f32(rng, 0.0f, 2.0f * PI);
+  f32 distance = (f32)freya::sqrt(random_f32(rng)) * radius;
+
+  return Vec2(freya::cos(angle), freya::sin(angle)) * distance;
+}
+
+void random_fill_disc(Rng& rng, Vec2* out, const sizei count, const f32 radius) {
+  for(sizei i = 0; i < count; i++) {
+    out[i] = random_in_disc(rng, radius);
+  }
+}
+
 const f32 random_f32() {
-  std::uniform_real_distribution<f32> uni_dist;
-  return uni_dist(engine);
+  return random_f32(rng_get_default());
 }
 
 const f32 random_f32(const f32 min, const f32 max) {
-  std::uniform_real_distribution<f32> uni_dist(min, max);
-  return uni_dist(engine);
+  return random_f32(rng_get_default(), min, max);
 }
 
 const f64 random_f64() {
-  std::uniform_real_distribution<f64> uni_dist;
-  return uni_dist(engine);
+  return random_f64(rng_get_default());
 }
 
 const f64 random_f64(const f64 min, const f64 max) {
-  std::uniform_real_distribution<f64> uni_dist(min, max);
-  return uni_dist(engine);
+  return min + ((max - min) * random_f64(rng_get_default()));
 }
 
 const i32 random_i32() {
-  std::uniform_int_distribution<i32> uni_dist;
-  return uni_dist(engine);
+  return (i32)random_u64(rng_get_default(), 0, INT_MAX);
 }
 
 const i32 random_i32(const i32 min, const i32 max) {
-  std::uniform_int_distribution<i32> uni_dist(min, max);
-  return uni_dist(engine);
+  return random_i32(rng_get_default(), min, max);
 }
 
 const i64 random_i64() {
-  std::uniform_int_distribution<i64> uni_dist;
-  return uni_dist(engine);
+  return (i64)random_u64(rng_get_default(), 0, LLONG_MAX);
 }
 
 const i64 random_i64(const i64 min, const i64 max) {
-  std::uniform_int_distribution<i64> uni_dist(min, max);
-  return uni_dist(engine);
+  return min + (i64)random_u64(rng_get_default(), 0, (u64)max - (u64)min);
 }
 
-const u32 random_u32() { 
-  std::uniform_int_distribution<u32> uni_dist;
-  return uni_dist(engine);
+const u32 random_u32() {
+  return random_u32(rng_get_default());
 }
 
 const u32 random_u32(const u32 min, const u32 max) {
-  std::uniform_int_distribution<u32> uni_dist(min, max);
-  return uni_dist(engine);
+  return random_u32(rng_get_default(), min, max);
 }
 
 const u64 random_u64() {
-  std::uniform_int_distribution<u64> uni_dist;
-  return uni_dist(engine);
+  return random_u64(rng_get_default());
 }
 
 const u64 random_u64(const u64 min, const u64 max) {
-  std::uniform_int_distribution<u64> uni_dist(min, max);
-  return uni_dist(engine);
+  return random_u64(rng_get_default(), min, max);
 }
 
 /// Math random functions
@@ -3,6 +3,7 @@
 #include "freya_logger.h"
 #include "freya_event.h"
 #include "freya_render.h"
+#include "freya_timer.h"
 
 #include <box2d/box2d.h>
 
@@ -13,7 +14,11 @@ namespace freya { // Start of freya
 ///---------------------------------------------------------------------------------------------------------------------
 /// Consts
 
-const f64 PHYSICS_FIXED_DELTA_TIME = 1 / 60.0;
+const f64 PHYSICS_FIXED_DELTA_TIME    = 1 / 60.0;
+const i32 PHYSICS_MAX_STEPS_PER_FRAME = 8;
+
+const u32 DEBUG_CIRCLE_SEGMENTS = 16;
+const f32 DEBUG_LINE_THICKNESS  = 1.0f;
 
 /// Consts
 ///---------------------------------------------------------------------------------------------------------------------
@@ -27,10 +32,16 @@ struct PhysicsWorld {
   bool is_paused = false;
   bool is_debug  = false;
 
-  f32 timestep = PHYSICS_FIXED_DELTA_TIME;
-  f32 speed    = 1.0f;
+  f32 timestep    = PHYSICS_FIXED_DELTA_TIME;
+  f32 speed       = 1.0f;
+  f64 accumulator = 0.0;
+
+  u64 steps_count = 0;
+  DynamicArray<PhysicsBodyMoveEvent> move_events; // Re-filled every `physics_world_step`
 
   Color debug_color = Color(1.0f, 0.0f, 1.0f, 0.3f);
+  DynamicArray<Vec2> debug_vertices; // Triangles list, re-filled every debug draw
+
   Queue<OnCastHitFn> funcs;
 };
 
@@ -94,148 +105,42 @@ static b2ShapeDef define_shape_def(const ColliderDesc& desc) {
   return shape_def;
 }
 
-/// Private functions
-///---------------------------------------------------------------------------------------------------------------------
-
-///---------------------------------------------------------------------------------------------------------------------
-/// Callbacks
-
-static f32 on_cast_hit(b2ShapeId shape, b2Vec2 point, b2Vec2 b2normal, f32 fraction, void* context) {
-  // Build the result
-
-  CastResult cast_result = {
-    .body = b2Shape_GetBody(shape),
-
-    .point    = b2vec_to_vec(point),
-    .normal   = freya::Vec2(b2normal.x, b2normal.y),
-    .fraction = fraction,
-  };
-
-  // Get the latest function
-  
-  OnCastHitFn hit_func = s_world.funcs.back();
-  s_world.funcs.pop();
-  
-  // Initate the callback
-
-  f32 result = 0.0f;
-  if(hit_func) {
-    result = hit_func(cast_result);
-  }
-
-  // Done!
-  return result;
+static void debug_push_triangle(const Vec2& p1, const Vec2& p2, const Vec2& p3) {
+  s_world.debug_vertices.push_back(p1);
+  s_world.debug_vertices.push_back(p2);
+  s_world.debug_vertices.push_back(p3);
 }
 
-static void b2draw_circle(b2Transform b2transform, f32 radius, b2HexColor b2color, void* context) {
-  // @TODO (Box2D/Draw)
-}
+static void debug_push_circle(const Vec2& center, const f32 radius) {
+  f32 step  = (2.0f * PI) / (f32)DEBUG_CIRCLE_SEGMENTS;
+  Vec2 prev = center + Vec2(radius, 0.0f);
 
-static void b2draw_polygon(b2Transform b2transform, const b2Vec2* b2vertices, i32 vertex_count, f32 radius, b2HexColor b2color, void* context) {
-  // Setting up the state for rendering
+  for(u32 i = 1; i <= DEBUG_CIRCLE_SEGMENTS; i++) {
+    f32 angle = step * (f32)i;
+    Vec2 next = center + Vec2(glm::cos(angle), glm::sin(angle)) * radius;
 
-  DynamicArray<Vec2> vertices(vertex_count);
-  
-  Vec2 min = Vec2(FLOAT_MAX);
-  Vec2 max = Vec2(FLOAT_MIN);
-
-  for(sizei i = 0; i < vertices.size(); i++) {
-    vertices[i] = (b2vec_to_vec(b2vertices[i]) * 2.0f); // It's usually half the size, so we scale it
-     
-    min = vec2_min(vertices[i], min);
-    max = vec2_max(vertices[i], max);
+    debug_push_triangle(center, prev, next);
+    prev = next;
   }
+}
 
-  // Assume that this is a quad with 4 vertices
-
-  if(vertex_count == 4) { 
-    Transform transform = {
-      .position = b2vec_to_vec(b2transform.p),
-      .scale    = max,
-      .rotation = b2Rot_GetAngle(b2transform.q),
-    };
-    renderer_queue_quad(transform, s_world.debug_color);
+static void debug_push_line(const Vec2& start, const Vec2& end, const f32 thickness) {
+  Vec2 direction = end - start;
+  f32 length     = glm::length(direction);
 
+  if(length <= 0.0f) {
     return;
   }
 
-  // Other polygon
+  // Extrude the line into a thin quad
 
-  Transform transform = {
-    .position = b2vec_to_vec(b2transform.p),
-    .scale    = (radius > 0.0f) ? Vec2(radius * 100.0f) : Vec2(1.0f),
-    .rotation = b2Rot_GetAngle(b2transform.q),
-  };
-  renderer_queue_triangles_strip(transform, vertices, s_world.debug_color);
-}
+  Vec2 normal = Vec2(-direction.y, direction.x) * ((thickness * 0.5f) / length);
 
-static void b2draw_point(b2Vec2 p, float size, b2HexColor b2color, void* context) {
-  renderer_queue_point(b2vec_to_vec(p), size * 100.0f, s_world.debug_color);
-}
-
-static void b2draw_line(b2Vec2 p1, b2Vec2 p2, b2HexColor b2color, void* context) {
-  Vec2 start = b2vec_to_vec(p1);
-  Vec2 end   = b2vec_to_vec(p2);
-
-  renderer_queue_line(start, end, s_world.debug_color);
+  debug_push_triangle(start - normal, end - normal, end + normal);
+  debug_push_triangle(start - normal, end + normal, start + normal);
 }
 
-/// Callbacks
-///---------------------------------------------------------------------------------------------------------------------
-
-///---------------------------------------------------------------------------------------------------------------------
-/// Physics world functions
-
-void physics_world_init(const Vec2& gravity) {
-  // Def init
-
-  b2WorldDef world_def = b2DefaultWorldDef();
-  world_def.gravity    = vec_to_b2vec(gravity);
-
-  // World init
-  s_world.id = b2CreateWorld(&world_def);
-
-  // Debug draw def init
-  
-  s_world.draw_def            = b2DefaultDebugDraw();
-  s_world.draw_def.drawShapes = true;
-
-  s_world.draw_def.DrawSolidCircleFcn  = b2draw_circle;
-  s_world.draw_def.DrawSolidPolygonFcn = b2draw_polygon;
-  s_world.draw_def.DrawPointFcn        = b2draw_point;
-  s_world.draw_def.DrawSegmentFcn      = b2draw_line;
-
-  // Done!
-  FREYA_LOG_INFO("Successfully initialized the physics world");
-}
-
-void physics_world_shutdown() {
-  b2DestroyWorld(s_world.id);
-
-  FREYA_LOG_INFO("The physics world was successfully shutdown");
-}
-
-void physics_world_step(const i32 sub_steps) {
-  // Paused the world!
-
-  if(s_world.is_paused) {
-    return;
-  }
-
-  // Step the physics world, using an accurate delta time
-  //
-  // @NOTE: This is taken from the amazing gafferongames: 
-  // https://gafferongames.com/post/fix_your_timestep/
-  //
-  
-  s_world.timestep = (f32)clock_get_delta_time();
-  while(s_world.timestep > 0.0) {
-    f32 dt = freya::min_float(s_world.timestep, PHYSICS_FIXED_DELTA_TIME);
-    b2World_Step(s_world.id, dt * s_world.speed, sub_steps);
-
-    s_world.timestep -= dt;
-  }
-
+static void dispatch_world_events() {
   //
   // Handle contact events
   //
@@ -336,6 +241,242 @@ void physics_world_step(const i32 sub_steps) {
   }
 }
 
+static void collect_move_events(const u64 step) {
+  b2BodyEvents events = b2World_GetBodyEvents(s_world.id);
+
+  for(i32 i = 0; i < events.moveCount; i++) {
+    b2BodyMoveEvent* event = events.moveEvents + i;
+
+    PhysicsBodyMoveEvent move_event = {
+      .body        = event->bodyId,
+      .user_data   = (uintptr)event->userData,
+      .position    = b2vec_to_vec(event->transform.p),
+      .rotation    = b2Rot_GetAngle(event->transform.q),
+      .step        = step,
+      .fell_asleep = event->fellAsleep,
+    };
+    s_world.move_events.push_back(move_event);
+  }
+}
+
+/// Private functions
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Callbacks
+
+static f32 on_cast_hit(b2ShapeId shape, b2Vec2 point, b2Vec2 b2normal, f32 fraction, void* context) {
+  // Build the result
+
+  CastResult cast_result = {
+    .body = b2Shape_GetBody(shape),
+
+    .point    = b2vec_to_vec(point),
+    .normal   = freya::Vec2(b2normal.x, b2normal.y),
+    .fraction = fraction,
+  };
+
+  // Get the latest function
+  
+  OnCastHitFn hit_func = s_world.funcs.back();
+  s_world.funcs.pop();
+  
+  // Initate the callback
+
+  f32 result = 0.0f;
+  if(hit_func) {
+    result = hit_func(cast_result);
+  }
+
+  // Done!
+  return result;
+}
+
+static bool on_static_overlap(b2ShapeId shape, void* context) {
+  b2BodyId body = b2Shape_GetBody(shape);
+  if(b2Body_GetType(body) != b2_staticBody) { // Keep going...
+    return true;
+  }
+
+  DynamicArray<ColliderProxy>* proxies = (DynamicArray<ColliderProxy>*)context;
+  b2Transform transform                = b2Body_GetTransform(body);
+
+  ColliderProxy proxy = {};
+
+  switch(b2Shape_GetType(shape)) {
+    case b2_circleShape: {
+      b2Circle circle = b2Shape_GetCircle(shape);
+
+      proxy.points[0]    = b2vec_to_vec(b2TransformPoint(transform, circle.center));
+      proxy.points_count = 1;
+      proxy.radius       = circle.radius * PHYSICS_METERS_TO_PIXELS;
+    } break;
+    case b2_capsuleShape: {
+      b2Capsule capsule = b2Shape_GetCapsule(shape);
+
+      proxy.points[0]    = b2vec_to_vec(b2TransformPoint(transform, capsule.center1));
+      proxy.points[1]    = b2vec_to_vec(b2TransformPoint(transform, capsule.center2));
+      proxy.points_count = 2;
+      proxy.radius       = capsule.radius * PHYSICS_METERS_TO_PIXELS;
+    } break;
+    case b2_segmentShape: {
+      b2Segment segment = b2Shape_GetSegment(shape);
+
+      proxy.points[0]    = b2vec_to_vec(b2TransformPoint(transform, segment.point1));
+      proxy.points[1]    = b2vec_to_vec(b2TransformPoint(transform, segment.point2));
+      proxy.points_count = 2;
+    } break;
+    case b2_chainSegmentShape: {
+      b2ChainSegment chain_segment = b2Shape_GetChainSegment(shape);
+
+      proxy.points[0]    = b2vec_to_vec(b2TransformPoint(transform, chain_segment.segment.point1));
+      proxy.points[1]    = b2vec_to_vec(b2TransformPoint(transform, chain_segment.segment.point2));
+      proxy.points_count = 2;
+    } break;
+    case b2_polygonShape: {
+      b2Polygon polygon = b2Shape_GetPolygon(shape);
+
+      for(i32 i = 0; i < polygon.count; i++) {
+        proxy.points[i] = b2vec_to_vec(b2TransformPoint(transform, polygon.vertices[i]));
+      }
+
+      proxy.points_count = polygon.count;
+      proxy.radius       = polygon.radius * PHYSICS_METERS_TO_PIXELS;
+    } break;
+    default:
+      return true;
+  }
+
+  proxies->push_back(proxy);
+  return true;
+}
+
+static void b2draw_circle(b2Transform b2transform, f32 radius, b2HexColor b2color, void* context) {
+  debug_push_circle(b2vec_to_vec(b2transform.p), radius * PHYSICS_METERS_TO_PIXELS);
+}
+
+static void b2draw_capsule(b2Vec2 p1, b2Vec2 p2, f32 radius, b2HexColor b2color, void* context) {
+  Vec2 start     = b2vec_to_vec(p1);
+  Vec2 end       = b2vec_to_vec(p2);
+  f32 pixels_rad = radius * PHYSICS_METERS_TO_PIXELS;
+
+  debug_push_circle(start, pixels_rad);
+  debug_push_circle(end, pixels_rad);
+  debug_push_line(start, end, pixels_rad * 2.0f);
+}
+
+static void b2draw_polygon(b2Transform b2transform, const b2Vec2* b2vertices, i32 vertex_count, f32 radius, b2HexColor b2color, void* context) {
+  // The vertices are given in the local space of the body, 
+  // so bring them to the world before triangulating them as a fan.
+  
+  Vec2 first = b2vec_to_vec(b2TransformPoint(b2transform, b2vertices[0]));
+  Vec2 prev  = b2vec_to_vec(b2TransformPoint(b2transform, b2vertices[1]));
+
+  for(i32 i = 2; i < vertex_count; i++) {
+    Vec2 next = b2vec_to_vec(b2TransformPoint(b2transform, b2vertices[i]));
+
+    debug_push_triangle(first, prev, next);
+    prev = next;
+  }
+}
+
+static void b2draw_point(b2Vec2 p, float size, b2HexColor b2color, void* context) {
+  Vec2 center = b2vec_to_vec(p);
+  Vec2 extent = Vec2(size * 0.5f);
+
+  debug_push_triangle(center - extent, Vec2(center.x + extent.x, center.y - extent.y), center + extent);
+  debug_push_triangle(center - extent, center + extent, Vec2(center.x - extent.x, center.y + extent.y));
+}
+
+static void b2draw_line(b2Vec2 p1, b2Vec2 p2, b2HexColor b2color, void* context) {
+  Vec2 start = b2vec_to_vec(p1);
+  Vec2 end   = b2vec_to_vec(p2);
+
+  debug_push_line(start, end, DEBUG_LINE_THICKNESS);
+}
+
+/// Callbacks
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Physics world functions
+
+void physics_world_init(const Vec2& gravity) {
+  // Def init
+
+  b2WorldDef world_def = b2DefaultWorldDef();
+  world_def.gravity    = vec_to_b2vec(gravity);
+
+  // World init
+  s_world.id = b2CreateWorld(&world_def);
+
+  // Debug draw def init
+  
+  s_world.draw_def            = b2DefaultDebugDraw();
+  s_world.draw_def.drawShapes = true;
+
+  s_world.draw_def.DrawSolidCircleFcn  = b2draw_circle;
+  s_world.draw_def.DrawSolidCapsuleFcn = b2draw_capsule;
+  s_world.draw_def.DrawSolidPolygonFcn = b2draw_polygon;
+  s_world.draw_def.DrawPointFcn        = b2draw_point;
+  s_world.draw_def.DrawSegmentFcn      = b2draw_line;
+
+  s_world.debug_vertices.reserve(4096);
+
+  // Done!
+  FREYA_LOG_INFO("Successfully initialized the physics world");
+}
+
+void physics_world_shutdown() {
+  b2DestroyWorld(s_world.id);
+
+  FREYA_LOG_INFO("The physics world was successfully shutdown");
+}
+
+void physics_world_step(const i32 sub_steps) {
+  // The events of the last frame were already consumed
+  s_world.move_events.clear();
+
+  // Paused the world!
+
+  if(s_world.is_paused) {
+    return;
+  }
+
+  // Step the physics world at a fixed rate, carrying the left-over 
+  // time to the next frame. The remainder will be used to interpolate 
+  // the rendered bodies between the last two steps.
+  //
+  // @NOTE: This is taken from the amazing gafferongames: 
+  // https://gafferongames.com/post/fix_your_timestep/
+  //
+  
+  s_world.accumulator += clock_get_delta_time() * s_world.speed;
+
+  i32 steps = 0;
+  while(s_world.accumulator >= s_world.timestep) {
+    // Drop any remaining time if we fall too far behind, 
+    // rather than stepping more and more every frame.
+
+    if(steps >= PHYSICS_MAX_STEPS_PER_FRAME) {
+      s_world.accumulator = 0.0;
+      break;
+    }
+
+    b2World_Step(s_world.id, s_world.timestep, sub_steps);
+    
+    // Events are only valid until the next step
+
+    dispatch_world_events();
+    collect_move_events(s_world.steps_count + 1);
+
+    s_world.accumulator -= s_world.timestep;
+    s_world.steps_count += 1;
+    
+    steps++;
+  }
+}
+
 void physics_world_cast_ray(const RayCastDesc& cast_desc, const OnCastHitFn& hit_func) {
   // Build the filter
 
@@ -433,6 +574,19 @@ void physics_world_cast_collider(const ColliderCastDesc& cast_desc, const OnCast
                     nullptr);
 }
 
+void physics_world_query_static_colliders(const Rect2D& bounds, DynamicArray<ColliderProxy>& out_proxies) {
+  if(!b2World_IsValid(s_world.id)) {
+    return;
+  }
+
+  b2AABB aabb = {
+    .lowerBound = vec_to_b2vec(bounds.position),
+    .upperBound = vec_to_b2vec(bounds.position + bounds.size),
+  };
+
+  b2World_OverlapAABB(s_world.id, aabb, b2DefaultQueryFilter(), on_static_overlap, &out_proxies);
+}
+
 void physics_world_add_explosion(const ExplosionDesc& desc) {
   // Explosion def init
   
@@ -455,6 +609,11 @@ void physics_world_set_fixed_timestep(f32 timestep) {
   s_world.speed = timestep;
 }
 
+void physics_world_set_step_rate(const f32 rate) {
+  FREYA_DEBUG_ASSERT((rate > 0.0f), "The physics step rate must be bigger than 0");
+  s_world.timestep = 1.0f / rate;
+}
+
 void physics_world_set_debug_color(const Vec4& debug_color) {
   s_world.debug_color = debug_color;
 }
@@ -467,6 +626,22 @@ f32 physics_world_get_fixed_timestep() {
   return s_world.speed;
 }
 
+f32 physics_world_get_step_rate() {
+  return 1.0f / s_world.timestep;
+}
+
+f32 physics_world_get_interpolation_alpha() {
+  return (f32)(s_world.accumulator / s_world.timestep);
+}
+
+u64 physics_world_get_steps_count() {
+  return s_world.steps_count;
+}
+
+const DynamicArray<PhysicsBodyMoveEvent>& physics_world_get_move_events() {
+  return s_world.move_events;
+}
+
 Vec4 physics_world_get_debug_color() {
   return s_world.debug_color;
 }
@@ -487,8 +662,31 @@ const bool physics_world_is_debug() {
   return s_world.is_debug;
 }
 
-void physics_world_draw_debug() {
+void physics_world_draw_debug(const Rect2D& view_bounds) {
+  FREYA_PROFILE_FUNCTION();
+
+  // Only shapes that overlap the view will be sent back to us
+
+  Vec2 min = view_bounds.position;
+  Vec2 max = view_bounds.position + view_bounds.size;
+
+  s_world.draw_def.drawingBounds = b2AABB{
+    .lowerBound = vec_to_b2vec(min),
+    .upperBound = vec_to_b2vec(max),
+  };
+
+  // Gather all of the shapes into one list...
+
+  s_world.debug_vertices.clear();
   b2World_Draw(s_world.id, &s_world.draw_def);
+
+  // ...and draw them all at once
+
+  if(s_world.debug_vertices.empty()) {
+    return;
+  }
+
+  renderer_queue_triangles(s_world.debug_vertices.data(), s_world.debug_vertices.size(), s_world.debug_color);
 }
 
 /// Physics world functions
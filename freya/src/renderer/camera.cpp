@@ -6,6 +6,23 @@
 
 namespace freya { // Start of freya
 
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static void move_camera(Camera& cam, const Vec2& position) {
+  if(cam.position == position) {
+    return;
+  }
+
+  // Everything on screen moves along with the camera
+  
+  cam.position = position;
+  renderer_request_redraw();
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// Camera functions
 
@@ -37,7 +54,7 @@ void camera_move_top_down(Camera& cam, const Vec2& speed, const f32 delta_time)
     direction.x = 1.0f;
   }
 
-  cam.position += direction * speed * delta_time;
+  move_camera(cam, cam.position + (direction * speed * delta_time));
 }
 
 void camera_move_side_scroller(Camera& cam, const f32 speed, const f32 delta_time) {
@@ -50,15 +67,15 @@ void camera_move_side_scroller(Camera& cam, const f32 speed, const f32 delta_tim
     direction = 1.0f;
   }
 
-  cam.position.x += direction * speed * delta_time;
+  move_camera(cam, Vec2(cam.position.x + (direction * speed * delta_time), cam.position.y));
 }
 
 void camera_follow(Camera& cam, const Vec2& target, const Vec2& offset) {
-  cam.position = target + offset;
+  move_camera(cam, target + offset);
 }
 
 void camera_follow_lerp(Camera& cam, const Vec2& target, const Vec2& offset, const f32 delta) {
-  cam.position = vec2_lerp(cam.position, target + offset, delta);
+  move_camera(cam, vec2_lerp(cam.position, target + offset, delta));
 }
 
 Vec2 camera_world_to_screen_space(const Camera& cam, const Vec2& position) {
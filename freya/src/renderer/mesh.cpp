@@ -0,0 +1,209 @@
+#include "freya_render.h"
+#include "freya_logger.h"
+
+#include "shaders/mesh_shader.h"
+
+#include "sokol/sokol_gp.h"
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace freya { // Start of freya
+
+///---------------------------------------------------------------------------------------------------------------------
+/// MeshState
+struct MeshState {
+  sg_pipeline pipelines[MESH_PRIMITIVES_MAX] = {};
+  bool is_initialized                        = false;
+};
+
+static MeshState s_mesh;
+/// MeshState
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Private functions
+
+static sg_primitive_type get_sg_primitive(const MeshPrimitiveType primitive) {
+  switch(primitive) {
+    case MESH_PRIMITIVE_TRIANGLES:
+      return SG_PRIMITIVETYPE_TRIANGLES;
+    case MESH_PRIMITIVE_TRIANGLES_STRIP:
+      return SG_PRIMITIVETYPE_TRIANGLE_STRIP;
+    case MESH_PRIMITIVE_LINES:
+      return SG_PRIMITIVETYPE_LINES;
+    case MESH_PRIMITIVE_LINES_STRIP:
+      return SG_PRIMITIVETYPE_LINE_STRIP;
+    default:
+      return SG_PRIMITIVETYPE_TRIANGLES;
+  }
+}
+
+static void init_mesh_state() {
+  if(s_mesh.is_initialized) {
+    return;
+  }
+
+  // Shader init
+
+  AssetID shader_id = asset_group_push_shader(ASSET_CACHE_ID, *mesh_shader_desc(sg_query_backend()));
+  sg_shader shader  = asset_group_get_shader(shader_id);
+
+  // Pipelines init (one for each primitive type)
+
+  for(i32 i = 0; i < MESH_PRIMITIVES_MAX; i++) {
+    sg_pipeline_desc pipe_desc = {};
+
+    pipe_desc.shader         = shader;
+    pipe_desc.primitive_type = get_sg_primitive((MeshPrimitiveType)i);
+
+    pipe_desc.layout.attrs[ATTR_mesh_a_pos].format = SG_VERTEXFORMAT_FLOAT2;
+
+    // Same blending as the painter's
+
+    pipe_desc.colors[0].blend.enabled          = true;
+    pipe_desc.colors[0].blend.src_factor_rgb   = SG_BLENDFACTOR_SRC_ALPHA;
+    pipe_desc.colors[0].blend.dst_factor_rgb   = SG_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+    pipe_desc.colors[0].blend.src_factor_alpha = SG_BLENDFACTOR_ONE;
+    pipe_desc.colors[0].blend.dst_factor_alpha = SG_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+
+    pipe_desc.label = "mesh_pipeline";
+
+    s_mesh.pipelines[i] = sg_make_pipeline(pipe_desc);
+  }
+
+  // Done!
+  s_mesh.is_initialized = true;
+}
+
+static Rect2D get_world_bounds(const Mesh2D& mesh, const Transform& transform) {
+  // Put each corner of the local bounds through the same
+  // transform the painter will use (scale, rotate, then translate)
+
+  const Vec2 corners[4] = {
+    mesh.bounds.position,
+    mesh.bounds.position + Vec2(mesh.bounds.size.x, 0.0f),
+    mesh.bounds.position + Vec2(0.0f, mesh.bounds.size.y),
+    mesh.bounds.position + mesh.bounds.size,
+  };
+
+  f32 cos_rot = freya::cos(transform.rotation);
+  f32 sin_rot = freya::sin(transform.rotation);
+
+  Vec2 min = Vec2(FLT_MAX);
+  Vec2 max = Vec2(-FLT_MAX);
+
+  for(auto& corner : corners) {
+    Vec2 scaled = corner * transform.scale;
+    Vec2 point  = transform.position + Vec2((scaled.x * cos_rot) - (scaled.y * sin_rot),
+                                            (scaled.x * sin_rot) + (scaled.y * cos_rot));
+
+    min = glm::min(min, point);
+    max = glm::max(max, point);
+  }
+
+  return Rect2D{
+    .size     = max - min,
+    .position = min,
+  };
+}
+
+/// Private functions
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Mesh2D functions
+
+void mesh2d_create(Mesh2D& out_mesh, const Mesh2DDesc& desc) {
+  FREYA_DEBUG_ASSERT(!desc.vertices.empty(), "Cannot create a Mesh2D with no vertices");
+
+  // The pipelines can only be created once the graphics context is alive
+  init_mesh_state();
+
+  // Buffer init
+
+  sg_buffer_desc buff_desc = {};
+
+  buff_desc.usage.vertex_buffer = true;
+  buff_desc.usage.immutable     = true;
+
+  buff_desc.data  = sg_range{desc.vertices.data(), desc.vertices.size() * sizeof(Vec2)};
+  buff_desc.label = "mesh2d_buffer";
+
+  out_mesh.buffer_id = asset_group_push_buffer(desc.group_id, buff_desc);
+  out_mesh.buffer    = asset_group_get_buffer(out_mesh.buffer_id);
+
+  out_mesh.vertices_count = (u32)desc.vertices.size();
+  out_mesh.primitive      = desc.primitive;
+
+  // Calculate the local bounds of the mesh
+
+  Vec2 min = desc.vertices[0];
+  Vec2 max = desc.vertices[0];
+
+  for(auto& vertex : desc.vertices) {
+    min = glm::min(min, vertex);
+    max = glm::max(max, vertex);
+  }
+
+  out_mesh.bounds = Rect2D{
+    .size     = max - min,
+    .position = min,
+  };
+}
+
+/// Mesh2D functions
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Renderer functions
+
+void renderer_queue_mesh(const Mesh2D& mesh, const Transform& transform, const Color& color) {
+  FREYA_DEBUG_ASSERT(s_mesh.is_initialized, "Cannot queue a Mesh2D that was never created");
+
+  // Nothing to draw if the mesh is out of view.
+  // (Which also saves us a needless flush)
+
+  if(!rect_in_rect(get_world_bounds(mesh, transform), renderer_get_view_rect())) {
+    return;
+  }
+
+  // The mesh lives outside of the painter's vertex stream, so
+  // anything queued before it must be drawn first.
+  sgp_flush();
+
+  // Let the painter calculate the final transform of the mesh
+
+  sgp_push_transform();
+
+  sgp_translate(transform.position.x, transform.position.y);
+  sgp_rotate(transform.rotation);
+  sgp_scale(transform.scale.x, transform.scale.y);
+
+  const sgp_mat2x3& mvp = sgp_query_state()->mvp;
+
+  MeshParams_t params = {
+    .u_mvp_x = {mvp.v[0][0], mvp.v[0][1], mvp.v[0][2], 0.0f},
+    .u_mvp_y = {mvp.v[1][0], mvp.v[1][1], mvp.v[1][2], 0.0f},
+    .u_color = {color.r, color.g, color.b, color.a},
+  };
+
+  sgp_pop_transform();
+
+  // Draw the mesh
+
+  sg_bindings bindings       = {};
+  bindings.vertex_buffers[0] = mesh.buffer;
+
+  sg_apply_pipeline(s_mesh.pipelines[mesh.primitive]);
+  sg_apply_bindings(bindings);
+  sg_apply_uniforms(UB_MeshParams, SG_RANGE(params));
+
+  sg_draw(0, mesh.vertices_count, 1);
+}
+
+/// Renderer functions
+///---------------------------------------------------------------------------------------------------------------------
+
+} // End of freya
+
+//////////////////////////////////////////////////////////////////////////
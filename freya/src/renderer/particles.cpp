@@ -1,39 +1,782 @@
 #include "freya_render.h"
+#include "freya_logger.h"
 #include "freya_timer.h"
+#include "freya_threads.h"
+
+#include <algorithm>
+#include <cstring>
+#include <cfloat>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define FREYA_PARTICLES_SIMD 1
+  #include <emmintrin.h>
+#else
+  #define FREYA_PARTICLES_SIMD 0
+#endif
 
 //////////////////////////////////////////////////////////////////////////
 
 namespace freya { // Start of freya 
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Consts
+
+/// The minimum amount of particles the pool grows by whenever it runs out of space.
+const u32 PARTICLE_POOL_MIN_GROWTH = 1024;
+
+/// The amount of particles simulated by a single task. Bigger emitters 
+/// are split into chunks of this size.
+///
+/// @NOTE: This must stay a multiple of 4 so that chunks never share a SIMD lane.
+const i32 PARTICLE_CHUNK_SIZE = 4096;
+
+/// Below this many live particles, the update is not worth handing out to the workers.
+const i32 PARTICLE_PARALLEL_THRESHOLD = PARTICLE_CHUNK_SIZE * 2;
+
+/// The padding (in pixels) around the particles of an emitter when querying the 
+/// physics world for colliders. Anything further away than that is ignored.
+const f32 PARTICLE_COLLISION_MARGIN = 64.0f;
+
+/// The amount of steps the colliders of an emitter are cached for (as long 
+/// as the particles stay within the queried region), before being queried again. 
+const u32 PARTICLE_COLLISION_REFRESH_STEPS = 60;
+
+/// How far (in pixels) a particle is placed off a surface it collided with.
+const f32 PARTICLE_COLLISION_SKIN = 0.01f;
+
+/// Consts
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// ParticleCollider
+struct ParticleCollider {
+  ColliderProxy proxy;
+  Vec2 normals[COLLIDER_PROXY_POINTS_MAX]; // Only used by polygons
+
+  Vec2 min, max; // Including the radius
+};
+/// ParticleCollider
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// ParticleColliderCache
+struct ParticleColliderCache {
+  DynamicArray<ParticleCollider> colliders;
+  
+  Vec2 query_min = Vec2(0.0f), query_max = Vec2(-1.0f);         // The last region queried
+  Vec2 particles_min = Vec2(0.0f), particles_max = Vec2(-1.0f); // The region the particles covered last step
+
+  u32 steps_left = 0;
+};
+/// ParticleColliderCache
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// ParticleRange
+struct ParticleRange {
+  u32 offset    = 0; 
+  u32 capacity  = 0;
+  bool is_alive = false;
+
+  ParticleColliderCache collision;
+};
+/// ParticleRange
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// ParticlePool
+struct ParticlePool {
+  DynamicArray<f32> positions_x, positions_y;
+  DynamicArray<f32> velocities_x, velocities_y;
+  DynamicArray<f32> forces_x, forces_y;
+  DynamicArray<f32> ages, lifetimes;
+
+  DynamicArray<ParticleRange> ranges;
+  DynamicArray<i32> free_ranges;
+
+  u32 size         = 0; // The end of the last allocated range
+  u32 wasted_count = 0; // The amount of particles owned by released ranges
+};
+
+static ParticlePool s_pool;
+/// ParticlePool
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// ParticleJob
+struct ParticleJob {
+  ParticleEmitter* emitter = nullptr;
+
+  i32 chunk       = 0; 
+  i32 spawn_start = 0; // Any particle at or past this index was spawned this step
+
+  Vec2 min = Vec2(0.0f), max = Vec2(-1.0f); // The region the chunk covered (only for physics collisions)
+};
+/// ParticleJob
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// ParticleScheduler
+struct ParticleScheduler {
+  ThreadPool workers;
+  
+  bool has_workers    = false;
+  bool is_initialized = false;
+
+  DynamicArray<ParticleJob> jobs;
+  DynamicArray<ParticleEmitter*> active_emitters;
+
+  DynamicArray<ColliderProxy> proxies;
+};
+
+static ParticleScheduler s_scheduler;
+/// ParticleScheduler
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Private functions
 
-static void apply_random_distribution(ParticleEmitter& emitter) {
-  for(i32 i = 0; i < emitter.particles_count; i++) {
-    emitter.velocities[i] *= Vec2(random_f32(-1.0f, 1.0f), 
-                                  random_f32(-1.0f, 1.0f));
+static void pool_resize(const u32 capacity) {
+  s_pool.positions_x.resize(capacity);
+  s_pool.positions_y.resize(capacity);
+  
+  s_pool.velocities_x.resize(capacity);
+  s_pool.velocities_y.resize(capacity);
+  
+  s_pool.forces_x.resize(capacity);
+  s_pool.forces_y.resize(capacity);
+  
+  s_pool.ages.resize(capacity);
+  s_pool.lifetimes.resize(capacity);
+}
+
+static void pool_move(const u32 dest, const u32 src, const u32 count) {
+  DynamicArray<f32>* streams[] = {
+    &s_pool.positions_x, &s_pool.positions_y, 
+    &s_pool.velocities_x, &s_pool.velocities_y, 
+    &s_pool.forces_x, &s_pool.forces_y,
+    &s_pool.ages, &s_pool.lifetimes,
+  };
+
+  for(auto& stream : streams) {
+    memmove(stream->data() + dest, stream->data() + src, count * sizeof(f32));
+  }
+}
+
+static i32 pool_allocate(const u32 count) {
+  // Always keep whole SIMD lanes, so that the integrator never 
+  // has to deal with a partial lane at the end of an emitter.
+  
+  u32 capacity = glm::max((count + 3) & ~3u, 4u);
+
+  // Grow the pool in bulk if needed
+
+  u32 pool_capacity = (u32)s_pool.positions_x.size();
+  if((s_pool.size + capacity) > pool_capacity) {
+    pool_resize(glm::max(s_pool.size + capacity, glm::max(pool_capacity * 2, PARTICLE_POOL_MIN_GROWTH)));
+  }
+
+  // Get a new range (or recycle an old one)
+
+  i32 range_id = (i32)s_pool.ranges.size();
+  if(!s_pool.free_ranges.empty()) {
+    range_id = s_pool.free_ranges.back();
+    s_pool.free_ranges.pop_back();
+  }
+  else {
+    s_pool.ranges.emplace_back();
+  }
+
+  s_pool.ranges[range_id] = ParticleRange {
+    .offset   = s_pool.size, 
+    .capacity = capacity, 
+    .is_alive = true,
+  };
+  s_pool.size += capacity;
+
+  // Done!
+  return range_id;
+}
+
+static void pool_release(const i32 range_id) {
+  ParticleRange& range = s_pool.ranges[range_id];
+  range.is_alive       = false;
+
+  range.collision = ParticleColliderCache{};
+
+  s_pool.free_ranges.push_back(range_id);
+
+  // The last range can just be popped off
+
+  if((range.offset + range.capacity) == s_pool.size) {
+    s_pool.size -= range.capacity;
+    return;
+  }
+
+  // Otherwise, compact once half of the pool is wasted
+
+  s_pool.wasted_count += range.capacity;
+  if(s_pool.wasted_count > (s_pool.size / 2)) {
+    particle_pool_compact();
+  }
+}
+
+static void seed_chunk_rng(Rng& rng, const ParticleEmitter& emitter, const i32 chunk) {
+  // Every (step, chunk) pair gets its own stream. That way, the 
+  // results do not depend on which thread ends up running the chunk. 
+  //
+  // @NOTE: `rng_seed` scrambles the seed well enough that neighbouring steps do not overlap.
+
+  rng_seed(rng, emitter.seed ^ (emitter.steps_count << 24) ^ (u64)chunk);
+}
+
+static Vec2 sample_distribution(const ParticleEmitter& emitter, Rng& rng) {
+  switch(emitter.distribution) {
+    case DISTRIBUTION_RANDOM: 
+      return Vec2(random_f32(rng, -1.0f, 1.0f), random_f32(rng, -1.0f, 1.0f));
+    case DISTRIBUTION_SQUARE: 
+      return Vec2(random_f32(rng, -emitter.distribution_radius, emitter.distribution_radius), 
+                  random_f32(rng, -emitter.distribution_radius, emitter.distribution_radius));
+    case DISTRIBUTION_CIRCULAR: 
+      return random_in_disc(rng, emitter.distribution_radius);
+    default:
+      return Vec2(1.0f);
+  }
+}
+
+static void spawn_particles(const ParticleEmitter& emitter, ParticleStreams& particles, const i32 start, const i32 end, Rng& rng) {
+  for(i32 i = start; i < end; i++) {
+    Vec2 velocity = emitter.initial_velocity * sample_distribution(emitter, rng);
+
+    particles.positions_x[i]  = emitter.position.x;
+    particles.positions_y[i]  = emitter.position.y;
+    particles.velocities_x[i] = velocity.x;
+    particles.velocities_y[i] = velocity.y;
+    particles.forces_x[i]     = 0.0f;
+    particles.forces_y[i]     = 0.0f;
+
+    particles.ages[i]      = 0.0f;
+    particles.lifetimes[i] = glm::max(emitter.lifetime + random_f32(rng, -emitter.lifetime_variance, emitter.lifetime_variance), 0.0f);
+  }
+}
+
+static void recycle_particles(ParticleEmitter& emitter, const f32 delta_time) {
+  ParticleStreams particles = particle_emitter_get_streams(emitter);
+  i32 count                 = particles.count;
+
+  // Swap any dead particle with the last live one, which keeps 
+  // the live particles tightly packed at the front of the range. 
+  //
+  // @NOTE: The index does not move forward after a swap, since the 
+  // swapped particle still needs to be aged this frame.
+
+  for(i32 i = 0; i < count;) {
+    particles.ages[i] += delta_time;
+    if(particles.ages[i] < particles.lifetimes[i]) {
+      i++;
+      continue;
+    }
+
+    count--;
+
+    particles.positions_x[i]  = particles.positions_x[count];
+    particles.positions_y[i]  = particles.positions_y[count];
+    particles.velocities_x[i] = particles.velocities_x[count];
+    particles.velocities_y[i] = particles.velocities_y[count];
+    particles.forces_x[i]     = particles.forces_x[count];
+    particles.forces_y[i]     = particles.forces_y[count];
+    particles.ages[i]         = particles.ages[count];
+    particles.lifetimes[i]    = particles.lifetimes[count];
+  }
+
+  emitter.particles_count = count;
+}
+
+static void integrate_particles(const ParticleEmitter& emitter, ParticleStreams& particles, const i32 start, const i32 end, const f32 delta_time) {
+  // Each lane goes through the exact same steps: 
+  //
+  // 1. Accumulate the acceleration (the inverse mass is `-1.0f`) and the gravity. 
+  // 2. Integrate the velocity and the next position.
+  // 3. Only apply the next position on the axis that is still within the bounds.
+  // 4. Reset the forces.
+  
+#if FREYA_PARTICLES_SIMD == 1
+  // @NOTE: The ranges in the pool (and the chunks) are always a multiple 
+  // of 4, so it is fine to run over the end a little to fill the last lane.
+  
+  i32 lanes_end = (end + 3) & ~3;
+
+  const __m128 dt      = _mm_set1_ps(delta_time);
+  const __m128 gravity = _mm_set1_ps(emitter.gravity_factor);
+  const __m128 zero    = _mm_setzero_ps();
+  const __m128 max_x   = _mm_set1_ps(emitter.bounds.x);
+  const __m128 max_y   = _mm_set1_ps(emitter.bounds.y);
+
+  for(i32 i = start; i < lanes_end; i += 4) {
+    __m128 pos_x = _mm_loadu_ps(&particles.positions_x[i]);
+    __m128 pos_y = _mm_loadu_ps(&particles.positions_y[i]);
+    __m128 vel_x = _mm_loadu_ps(&particles.velocities_x[i]);
+    __m128 vel_y = _mm_loadu_ps(&particles.velocities_y[i]);
+
+    __m128 accel_x = _mm_sub_ps(zero, _mm_loadu_ps(&particles.forces_x[i]));
+    __m128 accel_y = _mm_sub_ps(gravity, _mm_loadu_ps(&particles.forces_y[i]));
+
+    vel_x = _mm_add_ps(vel_x, _mm_mul_ps(accel_x, dt));
+    vel_y = _mm_add_ps(vel_y, _mm_mul_ps(accel_y, dt));
+
+    __m128 next_x = _mm_add_ps(pos_x, _mm_mul_ps(vel_x, dt));
+    __m128 next_y = _mm_add_ps(pos_y, _mm_mul_ps(vel_y, dt));
+
+    __m128 inside_x = _mm_and_ps(_mm_cmpge_ps(next_x, zero), _mm_cmple_ps(next_x, max_x));
+    __m128 inside_y = _mm_and_ps(_mm_cmpge_ps(next_y, zero), _mm_cmple_ps(next_y, max_y));
+
+    pos_x = _mm_or_ps(_mm_and_ps(inside_x, next_x), _mm_andnot_ps(inside_x, pos_x));
+    pos_y = _mm_or_ps(_mm_and_ps(inside_y, next_y), _mm_andnot_ps(inside_y, pos_y));
+
+    _mm_storeu_ps(&particles.positions_x[i], pos_x);
+    _mm_storeu_ps(&particles.positions_y[i], pos_y);
+    _mm_storeu_ps(&particles.velocities_x[i], vel_x);
+    _mm_storeu_ps(&particles.velocities_y[i], vel_y);
+    _mm_storeu_ps(&particles.forces_x[i], zero);
+    _mm_storeu_ps(&particles.forces_y[i], zero);
+  }
+#else
+  for(i32 i = start; i < end; i++) {
+    particles.velocities_x[i] += -particles.forces_x[i] * delta_time;
+    particles.velocities_y[i] += (emitter.gravity_factor - particles.forces_y[i]) * delta_time;
+
+    f32 next_x = particles.positions_x[i] + (particles.velocities_x[i] * delta_time);
+    f32 next_y = particles.positions_y[i] + (particles.velocities_y[i] * delta_time);
+
+    particles.positions_x[i] = ((next_x >= 0.0f) && (next_x <= emitter.bounds.x)) ? next_x : particles.positions_x[i];
+    particles.positions_y[i] = ((next_y >= 0.0f) && (next_y <= emitter.bounds.y)) ? next_y : particles.positions_y[i];
+
+    particles.forces_x[i] = 0.0f;
+    particles.forces_y[i] = 0.0f;
+  }
+#endif
+}
+
+static void build_collider(const ColliderProxy& proxy, ParticleCollider& out_collider) {
+  out_collider.proxy = proxy;
+
+  // Bounding box
+
+  out_collider.min = proxy.points[0];
+  out_collider.max = proxy.points[0];
+
+  for(i32 i = 1; i < proxy.points_count; i++) {
+    out_collider.min = glm::min(out_collider.min, proxy.points[i]);
+    out_collider.max = glm::max(out_collider.max, proxy.points[i]);
+  }
+
+  out_collider.min -= proxy.radius;
+  out_collider.max += proxy.radius;
+
+  // Outward normals (counter-clockwise winding)
+
+  if(proxy.points_count < 3) {
+    return;
+  }
+
+  for(i32 i = 0; i < proxy.points_count; i++) {
+    Vec2 edge = proxy.points[(i + 1) % proxy.points_count] - proxy.points[i];
+    out_collider.normals[i] = glm::normalize(Vec2(edge.y, -edge.x));
+  }
+}
+
+static void refresh_colliders(ParticleEmitter& emitter) {
+  ParticleColliderCache& cache = s_pool.ranges[emitter.pool_range].collision;
+
+  // The region the particles could reach this step
+
+  Vec2 min = emitter.position;
+  Vec2 max = emitter.position;
+
+  if(cache.particles_min.x <= cache.particles_max.x) {
+    min = glm::min(min, cache.particles_min);
+    max = glm::max(max, cache.particles_max);
+  }
+
+  min -= PARTICLE_COLLISION_MARGIN;
+  max += PARTICLE_COLLISION_MARGIN;
+
+  // Still good!
+
+  bool is_covered = glm::all(glm::greaterThanEqual(min, cache.query_min)) && 
+                    glm::all(glm::lessThanEqual(max, cache.query_max));
+
+  if(is_covered && cache.steps_left > 0) {
+    cache.steps_left--;
+    return;
+  }
+
+  // Query a little more than needed, so that the particles 
+  // do not trigger a new query with every small movement.
+
+  cache.query_min  = min - PARTICLE_COLLISION_MARGIN;
+  cache.query_max  = max + PARTICLE_COLLISION_MARGIN;
+  cache.steps_left = PARTICLE_COLLISION_REFRESH_STEPS;
+
+  Rect2D query_rect = {
+    .size     = cache.query_max - cache.query_min,
+    .position = cache.query_min,
+  };
+
+  s_scheduler.proxies.clear();
+  physics_world_query_static_colliders(query_rect, s_scheduler.proxies);
+
+  cache.colliders.resize(s_scheduler.proxies.size());
+  for(sizei i = 0; i < s_scheduler.proxies.size(); i++) {
+    build_collider(s_scheduler.proxies[i], cache.colliders[i]);
+  }
+}
+
+static bool collide_segment(const Vec2& a, const Vec2& b, const Vec2& previous, Vec2& position, Vec2& out_normal) {
+  // Did the particle cross the segment this step?
+
+  Vec2 segment = b - a;
+  Vec2 motion  = position - previous;
+
+  f32 denom = (motion.x * segment.y) - (motion.y * segment.x);
+  if(freya::abs(denom) <= 1e-6f) { // Parallel
+    return false;
+  }
+
+  Vec2 offset = a - previous;
+  f32 t       = ((offset.x * segment.y) - (offset.y * segment.x)) / denom; // Along the motion
+  f32 u       = ((offset.x * motion.y) - (offset.y * motion.x)) / denom;   // Along the segment
+
+  if(t < 0.0f || t > 1.0f || u < 0.0f || u > 1.0f) {
+    return false;
+  }
+
+  // Push the particle back to the side it came from
+
+  out_normal = glm::normalize(Vec2(segment.y, -segment.x));
+  if(glm::dot(out_normal, previous - a) < 0.0f) {
+    out_normal = -out_normal;
+  }
+
+  position = previous + (motion * t) + (out_normal * PARTICLE_COLLISION_SKIN);
+  return true;
+}
+
+static bool collide_collider(const ParticleCollider& collider, const Vec2& previous, Vec2& position, Vec2& out_normal) {
+  const ColliderProxy& proxy = collider.proxy;
+
+  switch(proxy.points_count) {
+    case 1: { // Circle
+      Vec2 diff = position - proxy.points[0];
+      f32 dist  = glm::length(diff);
+
+      if(dist >= proxy.radius) {
+        return false;
+      }
+
+      out_normal = (dist > 1e-6f) ? (diff / dist) : Vec2(0.0f, -1.0f);
+      position   = proxy.points[0] + (out_normal * (proxy.radius + PARTICLE_COLLISION_SKIN));
+      
+      return true;
+    }
+    case 2: { // Capsule or segment
+      Vec2 a       = proxy.points[0];
+      Vec2 segment = proxy.points[1] - a;
+
+      f32 length_sq = glm::dot(segment, segment);
+      f32 t         = (length_sq > 0.0f) ? glm::clamp(glm::dot(position - a, segment) / length_sq, 0.0f, 1.0f) : 0.0f;
+
+      Vec2 closest = a + (segment * t);
+      Vec2 diff    = position - closest;
+      f32 dist     = glm::length(diff);
+
+      if(dist < proxy.radius) {
+        out_normal = (dist > 1e-6f) ? (diff / dist) : glm::normalize(Vec2(segment.y, -segment.x));
+        position   = closest + (out_normal * (proxy.radius + PARTICLE_COLLISION_SKIN));
+
+        return true;
+      }
+
+      // Thin segments (like chains) have no area to be inside of. The particle has to be swept instead.
+      return collide_segment(proxy.points[0], proxy.points[1], previous, position, out_normal);
+    }
+    default: { // Polygon
+      // Find the face the particle is the closest to (least deep)
+
+      f32 max_separation = -FLT_MAX;
+      i32 face           = 0;
+
+      for(i32 i = 0; i < proxy.points_count; i++) {
+        f32 separation = glm::dot(collider.normals[i], position - proxy.points[i]);
+        if(separation > max_separation) {
+          max_separation = separation;
+          face           = i;
+        }
+      }
+
+      if(max_separation >= proxy.radius) {
+        return false;
+      }
+
+      out_normal = collider.normals[face];
+      position  += out_normal * ((proxy.radius - max_separation) + PARTICLE_COLLISION_SKIN);
+
+      return true;
+    }
+  }
+}
+
+static void apply_bounce(const ParticleEmitter& emitter, const Vec2& normal, Vec2& velocity) {
+  f32 normal_speed = glm::dot(velocity, normal);
+  if(normal_speed >= 0.0f) { // Already moving away
+    return;
+  }
+
+  Vec2 normal_velocity  = normal * normal_speed;
+  Vec2 tangent_velocity = velocity - normal_velocity;
+
+  velocity = (tangent_velocity * (1.0f - emitter.friction)) - (normal_velocity * emitter.bounce);
+}
+
+static void collide_with_colliders(const ParticleEmitter& emitter, ParticleStreams& particles, const i32 start, const i32 end, const f32 delta_time) {
+  const DynamicArray<ParticleCollider>& colliders = s_pool.ranges[emitter.pool_range].collision.colliders;
+  if(colliders.empty()) {
+    return;
+  }
+
+  for(i32 i = start; i < end; i++) {
+    Vec2 position = Vec2(particles.positions_x[i], particles.positions_y[i]);
+    Vec2 velocity = Vec2(particles.velocities_x[i], particles.velocities_y[i]);
+    Vec2 previous = position - (velocity * delta_time);
+
+    Vec2 motion_min = glm::min(previous, position);
+    Vec2 motion_max = glm::max(previous, position);
+    
+    bool has_collided = false;
+
+    for(auto& collider : colliders) {
+      // Cheap rejection first
+
+      if(motion_max.x < collider.min.x || motion_min.x > collider.max.x || 
+         motion_max.y < collider.min.y || motion_min.y > collider.max.y) {
+        continue;
+      }
+
+      Vec2 normal;
+      if(!collide_collider(collider, previous, position, normal)) {
+        continue;
+      }
+
+      apply_bounce(emitter, normal, velocity);
+      has_collided = true;
+    }
+
+    if(!has_collided) {
+      continue;
+    }
+
+    particles.positions_x[i]  = position.x;
+    particles.positions_y[i]  = position.y;
+    particles.velocities_x[i] = velocity.x;
+    particles.velocities_y[i] = velocity.y;
+  }
+}
+
+static bool grid_is_solid(const ParticleCollisionGrid& grid, const IVec2& cell) {
+  if(cell.x < 0 || cell.y < 0 || cell.x >= grid.cells_count.x || cell.y >= grid.cells_count.y) {
+    return false;
+  }
+
+  return grid.cells[(cell.y * grid.cells_count.x) + cell.x] != 0;
+}
+
+static void collide_with_grid(const ParticleEmitter& emitter, ParticleStreams& particles, const i32 start, const i32 end, const f32 delta_time) {
+  const ParticleCollisionGrid* grid = emitter.collision_grid;
+  if(!grid || grid->cells.empty()) {
+    return;
+  }
+
+  for(i32 i = start; i < end; i++) {
+    Vec2 position = Vec2(particles.positions_x[i], particles.positions_y[i]);
+    Vec2 velocity = Vec2(particles.velocities_x[i], particles.velocities_y[i]);
+    Vec2 previous = position - (velocity * delta_time);
+
+    IVec2 cell = (IVec2)glm::floor((position - grid->position) / grid->cell_size);
+    if(!grid_is_solid(*grid, cell)) {
+      continue;
+    }
+
+    // Figure out which axis took the particle into the solid cell
+    
+    IVec2 previous_cell = (IVec2)glm::floor((previous - grid->position) / grid->cell_size);
+    
+    bool hit_x = grid_is_solid(*grid, IVec2(cell.x, previous_cell.y));
+    bool hit_y = grid_is_solid(*grid, IVec2(previous_cell.x, cell.y));
+
+    if(!hit_x && !hit_y) { // Right into a corner
+      hit_x = true; 
+      hit_y = true;
+    }
+
+    if(hit_x) {
+      position.x  = previous.x;
+      velocity.x *= -emitter.bounce;
+      velocity.y *= (1.0f - emitter.friction);
+    }
+    
+    if(hit_y) {
+      position.y  = previous.y;
+      velocity.y *= -emitter.bounce;
+      velocity.x *= (1.0f - emitter.friction);
+    }
+
+    particles.positions_x[i]  = position.x;
+    particles.positions_y[i]  = position.y;
+    particles.velocities_x[i] = velocity.x;
+    particles.velocities_y[i] = velocity.y;
+  }
+}
+
+static void fold_chunk_bounds(const ParticleJob& job) {
+  ParticleColliderCache& cache = s_pool.ranges[job.emitter->pool_range].collision;
+  if(job.min.x > job.max.x) { // Empty chunk
+    return;
+  }
+
+  if(cache.particles_min.x > cache.particles_max.x) {
+    cache.particles_min = job.min;
+    cache.particles_max = job.max;
+    
+    return;
+  }
+
+  cache.particles_min = glm::min(cache.particles_min, job.min);
+  cache.particles_max = glm::max(cache.particles_max, job.max);
+}
+
+static i32 begin_step(ParticleEmitter& emitter, const f32 delta_time) {
+  // Figure out how many particles to spawn this step (carrying over the fractions to the next step)
+  //
+  // @NOTE: Bursts are also queued up through the accumulator. 
+  
+  if(emitter.is_emitting) {
+    emitter.spawn_accumulator += emitter.spawn_rate * delta_time;
+  }
+
+  i32 spawn_count            = (i32)emitter.spawn_accumulator;
+  emitter.spawn_accumulator -= (f32)spawn_count;
+
+  // New particles always go to the end of the live set, 
+  // but never spawn more than the emitter can hold.
+
+  i32 spawn_start         = glm::clamp(emitter.particles_count, 0, emitter.particles_capacity);
+  emitter.particles_count = spawn_start + glm::min(spawn_count, emitter.particles_capacity - spawn_start);
+
+  // Get the colliders around the particles ready. 
+  //
+  // @NOTE: This has to happen here (on the main thread), since the physics world is not ours to share.
+
+  if(emitter.collision == PARTICLE_COLLISION_PHYSICS) {
+    refresh_colliders(emitter);
+    
+    ParticleColliderCache& cache = s_pool.ranges[emitter.pool_range].collision;
+    cache.particles_min          = Vec2(0.0f);
+    cache.particles_max          = Vec2(-1.0f);
   }
+  
+  emitter.steps_count++;
+  return spawn_start;
 }
 
-static void apply_square_distribution(ParticleEmitter& emitter) {
-  f32 min = -emitter.distribution_radius;
-  f32 max = emitter.distribution_radius;
+static i32 get_chunks_count(const ParticleEmitter& emitter) {
+  return (emitter.particles_count + PARTICLE_CHUNK_SIZE - 1) / PARTICLE_CHUNK_SIZE;
+}
+
+static void simulate_chunk(ParticleJob& job, const f32 delta_time) {
+  ParticleEmitter& emitter  = *job.emitter;
+  ParticleStreams particles = particle_emitter_get_streams(emitter);
+
+  i32 start = job.chunk * PARTICLE_CHUNK_SIZE;
+  i32 end   = glm::min(start + PARTICLE_CHUNK_SIZE, particles.count);
+
+  // Initialize any particles in this chunk that were just spawned
+  
+  i32 spawn_start = glm::max(start, job.spawn_start);
+  if(spawn_start < end) {
+    Rng rng; 
+    seed_chunk_rng(rng, emitter, job.chunk);
+    
+    spawn_particles(emitter, particles, spawn_start, end, rng);
+  }
+
+  // Apply the numarical integrator for each particle 
+  integrate_particles(emitter, particles, start, end, delta_time);
+
+  // Collide with the world (if needed)
 
-  for(i32 i = 0; i < emitter.particles_count; i++) {
-    emitter.velocities[i] *= Vec2(random_f32(min, max), 
-                                  random_f32(min, max));
+  switch(emitter.collision) {
+    case PARTICLE_COLLISION_PHYSICS: 
+      collide_with_colliders(emitter, particles, start, end, delta_time);
+      break;
+    case PARTICLE_COLLISION_GRID: 
+      collide_with_grid(emitter, particles, start, end, delta_time);
+      break;
+    default:
+      return;
+  }
+
+  // Keep track of where the particles went, so the 
+  // next step knows where to look for colliders.
+
+  if(emitter.collision != PARTICLE_COLLISION_PHYSICS || start >= end) {
+    return;
+  }
+
+  job.min = Vec2(particles.positions_x[start], particles.positions_y[start]);
+  job.max = job.min;
+
+  for(i32 i = start + 1; i < end; i++) {
+    Vec2 position = Vec2(particles.positions_x[i], particles.positions_y[i]);
+
+    job.min = glm::min(job.min, position);
+    job.max = glm::max(job.max, position);
   }
 }
 
-static void apply_circular_distribution(ParticleEmitter& emitter) {
-  for(i32 i = 0; i < emitter.particles_count; i++) {
-    f32 theta_angle = random_f32(0.0f, 2.0f * PI);
-    f32 radius      = random_f32(0.0f, 1.0f) * emitter.distribution_radius;
+static void end_step(ParticleEmitter& emitter, const f32 delta_time) {
+  // Age the particles, and recycle the dead ones
+  //
+  // @NOTE: The swaps can move particles across chunks, which is 
+  // why this is done over the whole emitter at once.
+  recycle_particles(emitter, delta_time);
 
-    emitter.velocities[i] *= Vec2(freya::cos(theta_angle) * radius, freya::sin(theta_angle) * radius); 
+  // Bye bye, emitter. Goodnight
+
+  if(!emitter.is_emitting && emitter.particles_count == 0) {
+    emitter.is_active = false; 
   }
 }
 
+static bool init_workers() {
+  if(s_scheduler.is_initialized) {
+    return s_scheduler.has_workers;
+  }
+  s_scheduler.is_initialized = true;
+
+  // @NOTE: No threads on the web. Everything stays on the main thread there.
+
+#if FREYA_PLATFORM_WEB != 1
+  // Leave one core for the main thread, which also helps out while waiting
+
+  sizei workers_count = (sizei)glm::max(std::thread::hardware_concurrency(), 2u) - 1;
+  thread_pool_create(s_scheduler.workers, "particle_workers", workers_count);
+
+  s_scheduler.has_workers = true;
+#endif
+
+  return s_scheduler.has_workers;
+}
+
 /// Private functions
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -41,11 +784,20 @@ static void apply_circular_distribution(ParticleEmitter& emitter) {
 /// ParticleEmitter functions
 
 void particle_emitter_create(ParticleEmitter& out_emitter, const ParticleEmitterDesc& desc) {
+  // Pool init (dropping any old particles, in case the emitter is being re-created)
+
+  if(out_emitter.pool_range != -1) {
+    pool_release(out_emitter.pool_range);
+  }
+
+  out_emitter.pool_range         = pool_allocate((u32)desc.count);
+  out_emitter.particles_capacity = desc.count;
+
   // Distribution variables init
 
   out_emitter.distribution_radius = desc.distribution_radius; 
   out_emitter.distribution        = desc.distribution;
-  out_emitter.particles_count     = desc.count;
+  out_emitter.particles_count     = 0;
   
   // Positional variables init 
   
@@ -53,25 +805,42 @@ void particle_emitter_create(ParticleEmitter& out_emitter, const ParticleEmitter
   out_emitter.initial_velocity = desc.velocity;
   out_emitter.bounds           = desc.bounds;
 
-  for(sizei i = 0; i < desc.count; i++) {
-    Transform& transform = out_emitter.transforms[i];
+  // @NOTE: The whole range is initialized (and not just `desc.count`), 
+  // since the update might touch a few particles past the count.
+
+  const ParticleRange& range = s_pool.ranges[out_emitter.pool_range];
 
-    transform.position = Vec2(-1000.0f); 
-    transform.scale    = desc.scale;
+  for(u32 i = range.offset; i < (range.offset + range.capacity); i++) {
+    s_pool.positions_x[i] = -1000.0f;
+    s_pool.positions_y[i] = -1000.0f;
   }
 
   // Physics variables init
 
-  for(sizei i = 0; i < desc.count; i++) {
-    out_emitter.forces[i] = Vec2(0.0f);
+  for(u32 i = range.offset; i < (range.offset + range.capacity); i++) {
+    s_pool.forces_x[i] = 0.0f;
+    s_pool.forces_y[i] = 0.0f;
   }
   
-  for(sizei i = 0; i < desc.count; i++) {
-    out_emitter.velocities[i] = desc.velocity;
+  for(u32 i = range.offset; i < (range.offset + range.capacity); i++) {
+    s_pool.velocities_x[i] = desc.velocity.x;
+    s_pool.velocities_y[i] = desc.velocity.y;
+  }
+  
+  for(u32 i = range.offset; i < (range.offset + range.capacity); i++) {
+    s_pool.ages[i]      = 0.0f;
+    s_pool.lifetimes[i] = 0.0f;
   }
   
   out_emitter.gravity_factor = desc.gravity_factor; 
 
+  // Collision variables init
+
+  out_emitter.collision      = desc.collision;
+  out_emitter.collision_grid = desc.collision_grid;
+  out_emitter.bounce         = desc.bounce;
+  out_emitter.friction       = desc.friction;
+
   // Render variables init
  
   if(desc.texture_id.get_id() != ASSET_ID_INVALID) {
@@ -80,24 +849,39 @@ void particle_emitter_create(ParticleEmitter& out_emitter, const ParticleEmitter
 
   out_emitter.color = desc.color;
 
-  // Timer init
- 
-  TimerDesc timer_desc = {
-    .limit = desc.lifetime, 
-  };
-  timer_create(out_emitter.lifetime, timer_desc);
+  out_emitter.color_over_life        = desc.color_over_life;
+  out_emitter.scale_over_life        = desc.scale_over_life;
+  out_emitter.is_aligned_to_velocity = desc.align_to_velocity;
+
+  // Spawning variables init
+  
+  out_emitter.lifetime          = desc.lifetime;
+  out_emitter.lifetime_variance = desc.lifetime_variance;
+  out_emitter.spawn_rate        = desc.spawn_rate;
+  out_emitter.spawn_accumulator = 0.0f;
+
+  out_emitter.seed        = (desc.seed != 0) ? desc.seed : random_u64();
+  out_emitter.steps_count = 0;
+  
+  out_emitter.is_emitting = false;
+  out_emitter.is_active   = false;
 }
 
-void particle_emitter_create(ParticleEmitter& out_emitter, const AssetID& config_id) {
-  // Get the LUA state 
-  lua_State* lua = asset_group_get_lua_state(config_id);
+bool particle_emitter_desc_load(ParticleEmitterDesc& out_desc, lua_State* lua) {
+  // Make sure the config actually has a particle table
+
+  if(lua_getglobal(lua, "particle") != LUA_TTABLE) {
+    FREYA_LOG_ERROR("Could not find a \'particle\' table in the given particle config");
+    
+    lua_pop(lua, 1);
+    return false;
+  }
 
   //
   // Fill the desc using the LUA config
   //
 
-  ParticleEmitterDesc desc;
-  lua_getglobal(lua, "particle");
+  ParticleEmitterDesc& desc = out_desc;
 
   // Velocity
   
@@ -109,18 +893,17 @@ void particle_emitter_create(ParticleEmitter& out_emitter, const AssetID& config
     
     lua_geti(lua, -1, 2);
     desc.velocity.y = lua_tonumber(lua, -1); 
-    lua_pop(lua, 1); 
-
     lua_pop(lua, 1);
-  } 
+  }
+  lua_pop(lua, 1);
 
   // Count
 
   type = lua_getfield(lua, -1, "count");
   if(type != LUA_TNIL) {
     desc.count = lua_tonumber(lua, -1);
-    lua_pop(lua, 1);
   }
+  lua_pop(lua, 1);
 
   // Scale
   
@@ -132,10 +915,9 @@ void particle_emitter_create(ParticleEmitter& out_emitter, const AssetID& config
     
     lua_geti(lua, -1, 2);
     desc.scale.y = lua_tonumber(lua, -1); 
-    lua_pop(lua, 1); 
-
     lua_pop(lua, 1);
   }
+  lua_pop(lua, 1);
 
   // Bounds
   
@@ -147,10 +929,9 @@ void particle_emitter_create(ParticleEmitter& out_emitter, const AssetID& config
     
     lua_geti(lua, -1, 2);
     desc.bounds.y = lua_tonumber(lua, -1); 
-    lua_pop(lua, 1); 
-
     lua_pop(lua, 1);
   }
+  lua_pop(lua, 1);
 
   // Color
   
@@ -170,26 +951,85 @@ void particle_emitter_create(ParticleEmitter& out_emitter, const AssetID& config
     
     lua_geti(lua, -1, 4);
     desc.color.a = lua_tonumber(lua, -1); 
-    lua_pop(lua, 1); 
+    lua_pop(lua, 1);
+  }
+  lua_pop(lua, 1);
 
+  // Color over life
+  
+  type = lua_getfield(lua, -1, "color_over_life");
+  if(type != LUA_TNIL) {
+    lua_geti(lua, -1, 1);
+    desc.color_over_life.r = lua_tonumber(lua, -1); 
+    lua_pop(lua, 1); 
+    
+    lua_geti(lua, -1, 2);
+    desc.color_over_life.g = lua_tonumber(lua, -1); 
+    lua_pop(lua, 1); 
+    
+    lua_geti(lua, -1, 3);
+    desc.color_over_life.b = lua_tonumber(lua, -1); 
+    lua_pop(lua, 1); 
+    
+    lua_geti(lua, -1, 4);
+    desc.color_over_life.a = lua_tonumber(lua, -1); 
     lua_pop(lua, 1);
   }
+  lua_pop(lua, 1);
+  
+  // Scale over life
+  
+  type = lua_getfield(lua, -1, "scale_over_life");
+  if(type != LUA_TNIL) {
+    lua_geti(lua, -1, 1);
+    desc.scale_over_life.x = lua_tonumber(lua, -1); 
+    lua_pop(lua, 1); 
+    
+    lua_geti(lua, -1, 2);
+    desc.scale_over_life.y = lua_tonumber(lua, -1); 
+    lua_pop(lua, 1);
+  }
+  lua_pop(lua, 1);
+  
+  // Align to velocity
+
+  type = lua_getfield(lua, -1, "align_to_velocity");
+  if(type != LUA_TNIL) {
+    desc.align_to_velocity = lua_toboolean(lua, -1);
+  }
+  lua_pop(lua, 1);
 
   // Lifetime
 
   type = lua_getfield(lua, -1, "lifetime");
   if(type != LUA_TNIL) {
     desc.lifetime = lua_tonumber(lua, -1);
-    lua_pop(lua, 1);
   }
+  lua_pop(lua, 1);
+  
+  // Lifetime variance
+
+  type = lua_getfield(lua, -1, "lifetime_variance");
+  if(type != LUA_TNIL) {
+    desc.lifetime_variance = lua_tonumber(lua, -1);
+  }
+  lua_pop(lua, 1);
+  
+  // Spawn rate
+
+  type = lua_getfield(lua, -1, "spawn_rate");
+  if(type != LUA_TNIL) {
+    desc.spawn_rate = lua_tonumber(lua, -1);
+  }
+  lua_pop(lua, 1);
   
   // Gravity factor
 
   type = lua_getfield(lua, -1, "gravity_factor");
   if(type != LUA_TNIL) {
     desc.gravity_factor = lua_tonumber(lua, -1);
-    lua_pop(lua, 1);
   }
+  lua_pop(lua, 1);
   
   // Distribution
 
@@ -208,20 +1048,69 @@ void particle_emitter_create(ParticleEmitter& out_emitter, const AssetID& config
     else if(type_str == "circular") {
       desc.distribution = DISTRIBUTION_CIRCULAR;
     }
-
-    lua_pop(lua, 1);
   }
+  lua_pop(lua, 1);
   
   // Radius
 
   type = lua_getfield(lua, -1, "radius");
   if(type != LUA_TNIL) {
     desc.distribution_radius = lua_tonumber(lua, -1);
-    lua_pop(lua, 1);
   }
+  lua_pop(lua, 1);
+  
+  // Collision
+  //
+  // @NOTE: Grids cannot be given through the config. Those 
+  // have to be set on the emitter itself.
+
+  type = lua_getfield(lua, -1, "collision");
+  if(type != LUA_TNIL) {
+    String type_str = lua_tostring(lua, -1);
+
+    if(type_str == "physics") {
+      desc.collision = PARTICLE_COLLISION_PHYSICS;
+    } 
+    else if(type_str == "grid") {
+      desc.collision = PARTICLE_COLLISION_GRID;
+    }
+  }
+  lua_pop(lua, 1);
+  
+  // Bounce
+
+  type = lua_getfield(lua, -1, "bounce");
+  if(type != LUA_TNIL) {
+    desc.bounce = lua_tonumber(lua, -1);
+  }
+  lua_pop(lua, 1);
+  
+  // Friction
+
+  type = lua_getfield(lua, -1, "friction");
+  if(type != LUA_TNIL) {
+    desc.friction = lua_tonumber(lua, -1);
+  }
+  lua_pop(lua, 1);
 
   // Done!
+  
   lua_pop(lua, 1);
+  return true;
+}
+
+void particle_emitter_create(ParticleEmitter& out_emitter, const AssetID& config_id) {
+  ParticleEmitterDesc desc;
+
+  // Packaged configs were already evaluated when the package was built, 
+  // while raw LUA configs still need to be evaluated here (mostly for development).
+
+  if(config_id == ASSET_TYPE_PARTICLE_CONFIG) {
+    desc = *asset_group_get_particle_config(config_id);
+  }
+  else if(!particle_emitter_desc_load(desc, asset_group_get_lua_state(config_id))) {
+    return;
+  }
 
   // Create the emitter
   particle_emitter_create(out_emitter, desc);
@@ -232,93 +1121,251 @@ void particle_emitter_update(ParticleEmitter& emitter, const f32 delta_time) {
     return;
   }
 
-  // Define bounds to use later in the loop
+  i32 spawn_start = begin_step(emitter, delta_time);
 
-  Vec2 min_bounds = Vec2(0.0f);
-  Vec2 max_bounds = emitter.bounds;
+  i32 chunks_count = get_chunks_count(emitter);
+  for(i32 i = 0; i < chunks_count; i++) {
+    ParticleJob job = {&emitter, i, spawn_start};
+    
+    simulate_chunk(job, delta_time);
+    fold_chunk_bounds(job);
+  }
 
-  // Apply the numarical integrator for each particle 
+  end_step(emitter, delta_time);
+}
 
-  for(i32 i = 0; i < emitter.particles_count; i++) {
-    // Calculate the acceleration
+void particle_emitters_update(const DynamicArray<ParticleEmitter*>& emitters, const f32 delta_time) {
+  FREYA_PROFILE_FUNCTION();
 
-    Vec2 acceleration = emitter.forces[i] * -1.0f; // -1.0f = inverse mass
-    acceleration.y   += emitter.gravity_factor;
+  s_scheduler.jobs.clear();
+  s_scheduler.active_emitters.clear();
 
-    // Apply the acceleration and velocities
+  // Split every active emitter into chunks 
+  
+  i32 particles_count = 0;
 
-    Transform& transform = emitter.transforms[i];
-    Vec2& velocity       = emitter.velocities[i];
+  for(auto& emitter : emitters) {
+    if(!emitter->is_active) {
+      continue;
+    }
 
-    // Make sure that we don't go beyond the bounds
+    i32 spawn_start = begin_step(*emitter, delta_time);
+    
+    i32 chunks_count = get_chunks_count(*emitter);
+    for(i32 i = 0; i < chunks_count; i++) {
+      s_scheduler.jobs.push_back(ParticleJob{emitter, i, spawn_start});
+    }
 
-    velocity     += acceleration * delta_time;
-    Vec2 next_pos = transform.position + (velocity * delta_time);
+    s_scheduler.active_emitters.push_back(emitter);
+    particles_count += emitter->particles_count;
+  }
 
-    // Only apply the position to the axis that within the bounds
+  // Not worth the trouble. Just do it here... 
+  //
+  // @NOTE: The chunks (and their random streams) are the exact same 
+  // either way, so the results do not depend on the path taken.
 
-    if((next_pos.x >= min_bounds.x) && (next_pos.x <= max_bounds.x)) {
-      transform.position.x = next_pos.x;
+  if(particles_count < PARTICLE_PARALLEL_THRESHOLD || !init_workers()) {
+    for(auto& job : s_scheduler.jobs) {
+      simulate_chunk(job, delta_time);
+      fold_chunk_bounds(job);
     }
 
-    if((next_pos.y >= min_bounds.y) && (next_pos.y <= max_bounds.y)) {
-      transform.position.y = next_pos.y;
+    for(auto& emitter : s_scheduler.active_emitters) {
+      end_step(*emitter, delta_time);
     }
 
-    // Reset the forces
-    emitter.forces[i] = Vec2(0.0f);
+    return;
   }
 
-  // Update the timer 
+  // Simulate the chunks on the workers. 
+  //
+  // @NOTE: Small chunks (from small emitters) are grouped together into one task, 
+  // so that a bunch of tiny emitters do not each pay for a whole task. 
 
-  timer_update(emitter.lifetime, delta_time);
-  if(!emitter.lifetime.has_runout) {
-    return;
+  ParticleJob* jobs = s_scheduler.jobs.data();
+  sizei first       = 0;
+  i32 batch_size    = 0;
+
+  for(sizei i = 0; i < s_scheduler.jobs.size(); i++) {
+    batch_size += glm::min(jobs[i].emitter->particles_count - (jobs[i].chunk * PARTICLE_CHUNK_SIZE), PARTICLE_CHUNK_SIZE);
+    if(batch_size < PARTICLE_CHUNK_SIZE && i != (s_scheduler.jobs.size() - 1)) {
+      continue;
+    }
+
+    thread_pool_push_task(s_scheduler.workers, [jobs, first, last = i + 1, delta_time]() {
+      for(sizei j = first; j < last; j++) {
+        simulate_chunk(jobs[j], delta_time);
+      }
+    });
+
+    first      = i + 1;
+    batch_size = 0;
   }
 
-  // Bye bye, emitter. Goodnight
-  emitter.is_active = false; 
+  thread_pool_wait(s_scheduler.workers);
+
+  for(auto& job : s_scheduler.jobs) {
+    fold_chunk_bounds(job);
+  }
+
+  // Recycle the particles of each emitter on the workers as well. 
+  // Each emitter has to be done as a whole, though.
+  
+  ParticleEmitter** active_emitters = s_scheduler.active_emitters.data();
+  first                             = 0;
+  batch_size                        = 0;
+
+  for(sizei i = 0; i < s_scheduler.active_emitters.size(); i++) {
+    batch_size += active_emitters[i]->particles_count;
+    if(batch_size < PARTICLE_CHUNK_SIZE && i != (s_scheduler.active_emitters.size() - 1)) {
+      continue;
+    }
+
+    thread_pool_push_task(s_scheduler.workers, [active_emitters, first, last = i + 1, delta_time]() {
+      for(sizei j = first; j < last; j++) {
+        end_step(*active_emitters[j], delta_time);
+      }
+    });
+
+    first      = i + 1;
+    batch_size = 0;
+  }
+
+  thread_pool_wait(s_scheduler.workers);
 }
 
 void particle_emitter_emit(ParticleEmitter& emitter, const Vec2& position) {
-  emitter.position = (position + (emitter.bounds / 2.0f));
-  
-  particle_emitter_reset(emitter);
+  emitter.position  = (position + (emitter.bounds / 2.0f));
   emitter.is_active = true;
 
-  // Applying the distribution
+  // Continuous emitters just (keep) spawning from the new position
 
-  switch(emitter.distribution) {
-    case DISTRIBUTION_RANDOM: 
-      apply_random_distribution(emitter);
-      break;
-    case DISTRIBUTION_SQUARE: 
-      apply_square_distribution(emitter);
-      break;
-    case DISTRIBUTION_CIRCULAR: 
-      apply_circular_distribution(emitter);
-      break;
-    default:
-      break;
+  if(emitter.spawn_rate > 0.0f) {
+    emitter.is_emitting = true;
+    return;
   }
+
+  // Otherwise, replace the whole emitter with a new burst. 
+  //
+  // @NOTE: The burst is spawned on the next update, same as any other particle.
+
+  particle_emitter_reset(emitter);
+  
+  emitter.is_active         = true;
+  emitter.spawn_accumulator = (f32)emitter.particles_capacity;
+}
+
+void particle_emitter_stop(ParticleEmitter& emitter) {
+  emitter.is_emitting       = false;
+  emitter.spawn_accumulator = 0.0f;
 }
 
 void particle_emitter_reset(ParticleEmitter& emitter) {
-  emitter.is_active = false;
-  timer_reset(emitter.lifetime);
-  
-  for(i32 i = 0; i < emitter.particles_count; i++) {
-    emitter.transforms[i].position = emitter.position;
-    emitter.transforms[i].scale    = emitter.initial_scale;
+  emitter.particles_count   = 0;
+  emitter.spawn_accumulator = 0.0f;
+
+  emitter.is_emitting = false;
+  emitter.is_active   = false;
+}
+
+void particle_emitter_destroy(ParticleEmitter& emitter) {
+  if(emitter.pool_range == -1) {
+    return;
   }
-  
-  for(i32 i = 0; i < emitter.particles_count; i++) {
-    emitter.forces[i] = Vec2(0.0f);
+
+  pool_release(emitter.pool_range);
+
+  emitter.pool_range         = -1;
+  emitter.particles_capacity = 0;
+  emitter.particles_count    = 0;
+  emitter.is_active          = false;
+}
+
+ParticleStreams particle_emitter_get_streams(const ParticleEmitter& emitter) {
+  if(emitter.pool_range == -1) {
+    return ParticleStreams{};
   }
+
+  const ParticleRange& range = s_pool.ranges[emitter.pool_range];
   
-  for(i32 i = 0; i < emitter.particles_count; i++) {
-    emitter.velocities[i] = emitter.initial_velocity;
+  return ParticleStreams {
+    .positions_x  = s_pool.positions_x.data() + range.offset,
+    .positions_y  = s_pool.positions_y.data() + range.offset,
+    .velocities_x = s_pool.velocities_x.data() + range.offset,
+    .velocities_y = s_pool.velocities_y.data() + range.offset,
+    .forces_x     = s_pool.forces_x.data() + range.offset,
+    .forces_y     = s_pool.forces_y.data() + range.offset,
+    .ages         = s_pool.ages.data() + range.offset,
+    .lifetimes    = s_pool.lifetimes.data() + range.offset,
+    .count        = glm::clamp(emitter.particles_count, 0, emitter.particles_capacity),
+  };
+}
+
+void particle_pool_compact() {
+  FREYA_PROFILE_FUNCTION();
+
+  // Go through the live ranges in the order they appear in the pool
+
+  DynamicArray<i32> live_ranges;
+  for(i32 i = 0; i < (i32)s_pool.ranges.size(); i++) {
+    if(s_pool.ranges[i].is_alive) {
+      live_ranges.push_back(i);
+    }
   }
+
+  std::sort(live_ranges.begin(), live_ranges.end(), [](const i32 a, const i32 b) {
+    return s_pool.ranges[a].offset < s_pool.ranges[b].offset;
+  });
+
+  // Slide each range down to fill the holes
+
+  u32 offset = 0;
+  for(auto& range_id : live_ranges) {
+    ParticleRange& range = s_pool.ranges[range_id];
+    
+    if(range.offset != offset) {
+      pool_move(offset, range.offset, range.capacity);
+      range.offset = offset;
+    }
+
+    offset += range.capacity;
+  }
+
+  s_pool.size         = offset;
+  s_pool.wasted_count = 0;
+
+  // Give back the memory if the pool is mostly empty
+
+  u32 pool_capacity = (u32)s_pool.positions_x.size();
+  if(pool_capacity > PARTICLE_POOL_MIN_GROWTH && (s_pool.size * 4) < pool_capacity) {
+    pool_resize(glm::max(s_pool.size * 2, PARTICLE_POOL_MIN_GROWTH));
+    
+    s_pool.positions_x.shrink_to_fit();
+    s_pool.positions_y.shrink_to_fit();
+    s_pool.velocities_x.shrink_to_fit();
+    s_pool.velocities_y.shrink_to_fit();
+    s_pool.forces_x.shrink_to_fit();
+    s_pool.forces_y.shrink_to_fit();
+    s_pool.ages.shrink_to_fit();
+    s_pool.lifetimes.shrink_to_fit();
+  }
+}
+
+void particle_pool_shutdown() {
+  if(s_scheduler.has_workers) {
+    thread_pool_destroy(s_scheduler.workers);
+  }
+
+  s_scheduler.has_workers    = false;
+  s_scheduler.is_initialized = false;
+  
+  s_scheduler.jobs.clear();
+  s_scheduler.active_emitters.clear();
+
+  // Give back all of the particles
+
+  s_pool = ParticlePool{};
 }
 
 /// ParticleEmitter functions
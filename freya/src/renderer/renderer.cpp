@@ -3,8 +3,10 @@
 #include "freya_event.h"
 #include "freya_entity.h"
 #include "freya_physics.h"
+#include "freya_timer.h"
 
 #include "shaders/default_pass_shader.h"
+#include "shaders/particle_shader.h"
 
 #include "fontstash/fontstash.h"
 
@@ -16,6 +18,26 @@
 
 namespace freya { // Start of freya
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Consts
+
+/// The amount of particle instances the particle buffer can hold initially. 
+/// The buffer will grow on its own if a frame needs more.
+const sizei PARTICLE_INSTANCES_MIN = 16384;
+
+/// Consts
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// ParticleInstance
+struct ParticleInstance {
+  Vec2 position; 
+  f32 rotation; 
+  f32 life; // The normalized age of the particle (`0.0f` at birth, `1.0f` at death)
+};
+/// ParticleInstance
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Renderer
 struct Renderer {
@@ -32,6 +54,13 @@ struct Renderer {
 
   sg_pipeline pipeline;
 
+  sg_pipeline particle_pipeline;
+  sg_buffer particle_buffer;
+  sizei particle_buffer_size = 0;
+  
+  Texture particle_texture; // Used for emitters without a texture
+  DynamicArray<ParticleInstance> particle_instances;
+
   AssetGroupID group_id = ASSET_CACHE_ID;
   EntityWorld* world    = nullptr;
 
@@ -39,12 +68,33 @@ struct Renderer {
   bool can_sort    = false;
 
   FONScontext* fons = nullptr;
+
+  Rect2D view_rect = {};
+
+  RendererStats stats = {};
+  Array<RendererStats, RENDERER_STATS_HISTORY_MAX> stats_history = {};
+  u32 stats_head = 0;
+
+  PerfTimer prepare_timer, commit_timer;
+
+  bool can_skip_static = false;
+  bool is_dirty        = true;
 };
 
 static Renderer s_renderer;
 /// Renderer
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// RendererWatch
+
+/// Lives in the context of any world that was ever submitted, 
+/// so that its signals never get connected twice.
+struct RendererWatch {};
+
+/// RendererWatch
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Callbacks
 
@@ -63,6 +113,15 @@ static bool window_resized_callback(const Event& event, const void* dispatcher,
   return true;
 }
 
+static bool redraw_callback(const Event& event, const void* dispatcher, const void* listener) {
+  s_renderer.is_dirty = true;
+  return true;
+}
+
+static void component_changed_callback(EntityWorld& world, const EntityID entt) {
+  s_renderer.is_dirty = true;
+}
+
 static void sg_logger_func(const char* tag, 
                            u32 level, 
                            u32 item, 
@@ -93,6 +152,195 @@ static void sg_logger_func(const char* tag,
 ///---------------------------------------------------------------------------------------------------------------------
 /// Private functions
 
+static void calculate_view_rect() {
+  IVec2 frame_size = window_get_framebuffer_size(s_renderer.window);
+  Camera* camera   = s_renderer.main_cam;
+
+  // Without a camera, the world is projected straight onto the framebuffer
+
+  if(!camera || camera->zoom == 0.0f) {
+    s_renderer.view_rect = Rect2D{
+      .size     = Vec2(frame_size),
+      .position = Vec2(0.0f),
+    };
+    return;
+  }
+
+  // Undo the camera's transform (translate -> rotate -> scale) 
+  // on each corner of the view, and take the bounds of the result
+
+  Vec2 bounds     = Vec2(camera->view_bounds);
+  Vec2 corners[4] = {
+    camera->position, 
+    camera->position + Vec2(bounds.x, 0.0f), 
+    camera->position + Vec2(0.0f, bounds.y), 
+    camera->position + bounds, 
+  };
+
+  f32 sin_rot = glm::sin(-camera->rotation); 
+  f32 cos_rot = glm::cos(-camera->rotation); 
+
+  Vec2 min = Vec2(FLOAT_MAX);
+  Vec2 max = Vec2(-FLOAT_MAX);
+
+  for(auto& corner : corners) {
+    Vec2 point = Vec2(corner.x * cos_rot - corner.y * sin_rot, 
+                      corner.x * sin_rot + corner.y * cos_rot) / camera->zoom;
+
+    min = glm::min(min, point);
+    max = glm::max(max, point);
+  }
+
+  // Done!
+
+  s_renderer.view_rect = Rect2D{
+    .size     = max - min,
+    .position = min,
+  };
+}
+
+static bool is_in_view(const Vec2& position, const Vec2& size) {
+  // Rotated items can reach further than their size, so 
+  // the half-diagonal is used as a conservative extent.
+
+  f32 extent = glm::length(size) * 0.5f;
+  
+  Rect2D bounds = {
+    .size     = Vec2(extent * 2.0f), 
+    .position = position - extent,
+  };
+
+  return rect_in_rect(bounds, s_renderer.view_rect);
+}
+
+static void create_particle_buffer(const sizei size) {
+  if(s_renderer.particle_buffer_size > 0) {
+    sg_destroy_buffer(s_renderer.particle_buffer);
+  }
+
+  sg_buffer_desc buff_desc = {};
+
+  buff_desc.size                = size;
+  buff_desc.usage.vertex_buffer = true;
+  buff_desc.usage.stream_update = true;
+  buff_desc.label               = "particle_instances_buffer";
+
+  s_renderer.particle_buffer      = sg_make_buffer(buff_desc);
+  s_renderer.particle_buffer_size = size;
+}
+
+static void init_particle_state() {
+  // Shader init
+
+  AssetID shader_id = asset_group_push_shader(s_renderer.group_id, *particle_shader_desc(sg_query_backend()));
+  
+  // Pipeline init
+  
+  sg_pipeline_desc pipe_desc = {};
+
+  pipe_desc.shader         = asset_group_get_shader(shader_id);
+  pipe_desc.primitive_type = SG_PRIMITIVETYPE_TRIANGLE_STRIP;
+
+  // @NOTE: There are no per-vertex attributes. The corners of 
+  // each quad are derived from the vertex index in the shader.
+
+  pipe_desc.layout.buffers[0].step_func                   = SG_VERTEXSTEP_PER_INSTANCE;
+  pipe_desc.layout.attrs[ATTR_particle_a_instance].format = SG_VERTEXFORMAT_FLOAT4;
+
+  // Same blending as the painter's
+
+  pipe_desc.colors[0].blend.enabled          = true;
+  pipe_desc.colors[0].blend.src_factor_rgb   = SG_BLENDFACTOR_SRC_ALPHA;
+  pipe_desc.colors[0].blend.dst_factor_rgb   = SG_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+  pipe_desc.colors[0].blend.src_factor_alpha = SG_BLENDFACTOR_ONE;
+  pipe_desc.colors[0].blend.dst_factor_alpha = SG_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+
+  pipe_desc.label = "particle_pipeline";
+
+  s_renderer.particle_pipeline = sg_make_pipeline(pipe_desc);
+
+  // Instances buffer init
+  create_particle_buffer(PARTICLE_INSTANCES_MIN * sizeof(ParticleInstance));
+
+  // Default (white) texture init
+
+  u32 white_pixel = 0xffffffff;
+
+  sg_image_desc img_desc = {};
+
+  img_desc.width              = 1;
+  img_desc.height             = 1;
+  img_desc.pixel_format       = SG_PIXELFORMAT_RGBA8;
+  img_desc.data.mip_levels[0] = SG_RANGE(white_pixel);
+  img_desc.label              = "particle_default_texture";
+
+  Texture& texture = s_renderer.particle_texture;
+
+  texture.image   = sg_make_image(img_desc);
+  texture.sampler = s_renderer.default_sampler;
+  texture.size    = IVec2(1);
+
+  sg_view_desc view_desc  = {};
+  view_desc.texture.image = texture.image;
+
+  texture.view = sg_make_view(view_desc);
+}
+
+static void count_painter_command(const u32 vertices_count) {
+  s_renderer.stats.painter_commands += 1;
+  s_renderer.stats.painter_vertices += vertices_count;
+}
+
+static void stats_push_frame() {
+  RendererStats& stats = s_renderer.stats;
+
+  // Take the GPU-side numbers of the frame that was just committed
+
+  sg_frame_stats frame = sg_query_stats().prev_frame;
+
+  stats.draw_calls        = frame.num_draw + frame.num_draw_ex;
+  stats.pipeline_switches = frame.num_apply_pipeline;
+  stats.bindings_applied  = frame.num_apply_bindings;
+  stats.uniforms_applied  = frame.num_apply_uniforms;
+  stats.uploaded_bytes    = frame.size_update_buffer + frame.size_append_buffer + frame.size_update_image;
+  
+  stats.post_process_passes = (u32)s_renderer.passes.size();
+
+  // Push the frame to the history
+
+  s_renderer.stats_history[s_renderer.stats_head] = stats;
+  s_renderer.stats_head                           = (s_renderer.stats_head + 1) % RENDERER_STATS_HISTORY_MAX;
+}
+
+template<typename T>
+static void watch_component(EntityWorld& world) {
+  world.on_construct<T>().template connect<&component_changed_callback>();
+  world.on_update<T>().template connect<&component_changed_callback>();
+  world.on_destroy<T>().template connect<&component_changed_callback>();
+}
+
+static void watch_world(EntityWorld& world) {
+  if(world.ctx().contains<RendererWatch>()) {
+    return;
+  }
+  world.ctx().emplace<RendererWatch>();
+
+  // @NOTE: Transforms are not watched here, since they get tagged 
+  // with `TransformChanged` instead (see `entity_world_update`). 
+  // Anything else that changes in place has to go through 
+  // `EntityWorld::patch`/`EntityWorld::replace` to be seen.
+
+  watch_component<Camera>(world);
+  
+  watch_component<SpriteComponent>(world);
+  watch_component<AnimationComponent>(world);
+  watch_component<Animator>(world);
+
+  watch_component<UIText>(world);
+  watch_component<UISprite>(world);
+  watch_component<UIButton>(world);
+}
+
 static void swapchain_pass_prepare() {
   // Set up the swapchain 
 
@@ -157,6 +405,8 @@ void renderer_init(Window* window) {
 
   sg_setup(&gfx_desc);
   FREYA_ASSERT_LOG(sg_isvalid(), "Failed to initialize the graphics context");
+
+  sg_enable_stats();
   
   // SGL init
 
@@ -171,7 +421,12 @@ void renderer_init(Window* window) {
 
   // SGP init
 
-  sgp_desc gp_desc = {};
+  // Enough room for heavy batches (like the physics debug draw), since
+  // anything past the limit gets dropped by the painter for the whole frame.
+
+  sgp_desc gp_desc     = {};
+  gp_desc.max_vertices = 262144;
+
   sgp_setup(&gp_desc);
   
   FREYA_ASSERT_LOG(sgp_is_valid(), "Failed to initialize the graphics painter");
@@ -240,12 +495,37 @@ void renderer_init(Window* window) {
 
   s_renderer.pipeline = sg_make_pipeline(pipe_desc);
 
+  // Particles init
+  init_particle_state();
+
   // Listen to events
   
   event_register(EVENT_WINDOW_MAXIMIZED, window_resized_callback);
   event_register(EVENT_WINDOW_FRAMEBUFFER_RESIZED, window_resized_callback);
   event_register(EVENT_WINDOW_FULLSCREEN, window_resized_callback);
 
+  // Anything the world itself cannot tell us about should force a redraw
+
+  event_register(EVENT_WINDOW_MOVED, redraw_callback);
+  event_register(EVENT_WINDOW_MAXIMIZED, redraw_callback);
+  event_register(EVENT_WINDOW_FOCUSED, redraw_callback);
+  event_register(EVENT_WINDOW_RESIZED, redraw_callback);
+  event_register(EVENT_WINDOW_FRAMEBUFFER_RESIZED, redraw_callback);
+  event_register(EVENT_WINDOW_FULLSCREEN, redraw_callback);
+  
+  event_register(EVENT_MOUSE_MOVED, redraw_callback);
+  event_register(EVENT_MOUSE_BUTTON_PRESSED, redraw_callback);
+  event_register(EVENT_MOUSE_BUTTON_RELEASED, redraw_callback);
+  event_register(EVENT_MOUSE_SCROLL_WHEEL, redraw_callback);
+  event_register(EVENT_KEY_PRESSED, redraw_callback);
+  event_register(EVENT_KEY_RELEASED, redraw_callback);
+  
+  event_register(EVENT_ASSET_GROUP_LOADED, redraw_callback);
+  event_register(EVENT_ENTITY_ADDED, redraw_callback);
+  event_register(EVENT_ENTITY_DESTROYED, redraw_callback);
+  event_register(EVENT_ENTITIES_ADDED, redraw_callback);
+  event_register(EVENT_ENTITIES_DESTROYED, redraw_callback);
+
   // Done!
   FREYA_LOG_INFO("Successfully initialized the renderer context");
 }
@@ -258,6 +538,9 @@ void renderer_shutdown() {
   }
   s_renderer.passes.clear();
 
+  // Particles shutdown
+  particle_pool_shutdown();
+
   // GFX shutdown
 
   sfons_destroy(s_renderer.fons);
@@ -275,7 +558,18 @@ void renderer_apply_asset_group(const AssetGroupID& group_id) {
 }
 
 void renderer_sumbit_world(EntityWorld* world) {
-  s_renderer.world = world;
+  if(s_renderer.world == world) {
+    return;
+  }
+
+  s_renderer.world    = world;
+  s_renderer.is_dirty = true;
+
+  // Listen to any changes that could show up on screen
+  
+  if(world) {
+    watch_world(*world);
+  }
 }
 
 void renderer_push_post_process(PostProcessPass* pass) {
@@ -288,6 +582,7 @@ void renderer_push_post_process(PostProcessPass* pass) {
   }
 
   s_renderer.passes.push_back(pass);
+  s_renderer.is_dirty = true;
 
   // Some useful info
   FREYA_LOG_TRACE("Pushed post-process \'%s\' to the chain", pass->debug_name.c_str());
@@ -305,6 +600,8 @@ PostProcessPass* renderer_pop_post_process() {
 
   PostProcessPass* pass = s_renderer.passes.back();
   s_renderer.passes.pop_back();
+  
+  s_renderer.is_dirty = true;
 
   // Done!
 
@@ -313,13 +610,41 @@ PostProcessPass* renderer_pop_post_process() {
 }
 
 void renderer_set_clear_color(const Color& color) {
-  s_renderer.color = color;
+  s_renderer.color    = color;
+  s_renderer.is_dirty = true;
 }
 
 void renderer_set_sort(bool sort) {
   s_renderer.can_sort = sort;
 }
 
+void renderer_set_skip_static_frames(const bool skip) {
+  s_renderer.can_skip_static = skip;
+  s_renderer.is_dirty        = true;
+}
+
+void renderer_request_redraw() {
+  s_renderer.is_dirty = true;
+}
+
+const bool renderer_needs_redraw() {
+  if(!s_renderer.can_skip_static || s_renderer.is_dirty || !s_renderer.world) {
+    return true;
+  }
+
+  // Active particles are bound to change every frame
+
+  auto view = s_renderer.world->view<ParticleEmitter>();
+  for(auto entt : view) {
+    if(view.get<ParticleEmitter>(entt).is_active) {
+      return true;
+    }
+  }
+
+  // Nothing changed since the last frame
+  return false;
+}
+
 const Color& renderer_get_clear_color() {
   return s_renderer.color;
 }
@@ -342,10 +667,27 @@ sg_swapchain renderer_get_default_swapchain() {
   return swapchain;
 }
 
+const Rect2D& renderer_get_view_rect() {
+  return s_renderer.view_rect;
+}
+
 AssetGroupID& renderer_get_asset_group_id() {
   return s_renderer.group_id;
 }
 
+const RendererStats& renderer_get_stats() {
+  u32 last_frame = (s_renderer.stats_head + RENDERER_STATS_HISTORY_MAX - 1) % RENDERER_STATS_HISTORY_MAX;
+  return s_renderer.stats_history[last_frame];
+}
+
+const RendererStats* renderer_get_stats_history(u32* out_offset) {
+  if(out_offset) {
+    *out_offset = s_renderer.stats_head;
+  }
+
+  return s_renderer.stats_history.data();
+}
+
 void renderer_queue_texture(const Texture& texture, 
                             const Rect2D& src, 
                             const Rect2D& dest, 
@@ -366,6 +708,7 @@ void renderer_queue_texture(const Texture& texture,
   sgp_draw_textured_rect(0, 
                          {dest_pos.x, dest_pos.y, dest_size.x, dest_size.y},
                          {src_pos.x, src_pos.y, src_size.x, src_size.y}); 
+  count_painter_command(6);
 
   sgp_reset_view(0);
   sgp_reset_sampler(0);
@@ -391,11 +734,13 @@ void renderer_queue_quad(const Transform& transform, const Color& color) {
   
   Vec2 center = transform.position - (transform.scale / 2.0f);
   sgp_draw_filled_rect(center.x, center.y, transform.scale.x, transform.scale.y);
+  count_painter_command(6);
 }
 
 void renderer_queue_line(const Vec2& start, const Vec2& end, const Color& color) {
   sgp_set_color(color.r, color.g, color.b, color.a);
   sgp_draw_line(start.x, start.y, end.x, end.y);
+  count_painter_command(2);
 }
 
 void renderer_queue_point(const Vec2& position, f32 size, const Color& color) {
@@ -403,11 +748,25 @@ void renderer_queue_point(const Vec2& position, f32 size, const Color& color) {
   sgp_scale(size, size);
 
   sgp_draw_point(position.x, position.y);
+  count_painter_command(1);
 }
 
 void renderer_queue_triangle(const Vec2& p1, const Vec2& p2, const Vec2& p3, const Color& color) {
   sgp_set_color(color.r, color.g, color.b, color.a);
   sgp_draw_filled_triangle(p1.x, p1.y, p2.x, p2.y, p3.x, p3.y);
+  count_painter_command(3);
+}
+
+void renderer_queue_triangles(const Vec2* vertices, const sizei vertices_count, const Color& color) {
+  FREYA_DEBUG_ASSERT(((vertices_count % 3) == 0), "Triangles list must have a multiple of 3 vertices");
+
+  // `Vec2` and `sgp_point` are both two tightly-packed floats, so 
+  // the vertices can be handed to the painter as they are.
+  
+  sgp_set_color(color.r, color.g, color.b, color.a);
+  sgp_draw_filled_triangles((const sgp_triangle*)vertices, (u32)(vertices_count / 3));
+
+  count_painter_command((u32)vertices_count);
 }
 
 void renderer_queue_triangles_strip(const Transform& transform, const DynamicArray<Vec2>& vertices, const Color& color) {
@@ -427,6 +786,8 @@ void renderer_queue_triangles_strip(const Transform& transform, const DynamicArr
 
   sgp_draw_filled_triangles_strip(sgp_points.data(), vertices.size());
   sgp_pop_transform();
+  
+  count_painter_command((u32)vertices.size());
 }
 
 void renderer_queue_animation(const Animation& anim, const Transform& transform, const Color& tint) {
@@ -442,14 +803,83 @@ void renderer_queue_particles(const ParticleEmitter& emitter) {
     return;
   }
 
-  for(sizei i = 0; i < emitter.particles_count; i++) {
-    if(emitter.texture.id != -1) {
-      renderer_queue_texture(emitter.texture, emitter.transforms[i], emitter.color);
+  s_renderer.stats.particles_submitted += emitter.particles_count;
+
+  // Gather the visible particles into instances 
+  //
+  // @NOTE: The particles might grow over their lifetime, 
+  // so the bigger of the two scales is used for culling.
+
+  ParticleStreams particles = particle_emitter_get_streams(emitter);
+  Vec2 cull_scale           = glm::max(emitter.initial_scale, emitter.initial_scale * emitter.scale_over_life);
+  
+  DynamicArray<ParticleInstance>& instances = s_renderer.particle_instances;
+  instances.clear();
+  instances.reserve(particles.count);
+
+  for(i32 i = 0; i < particles.count; i++) {
+    Vec2 position = Vec2(particles.positions_x[i], particles.positions_y[i]);
+
+    if(!is_in_view(position, cull_scale)) {
+      s_renderer.stats.particles_culled++;
       continue;
     }
 
-    renderer_queue_quad(emitter.transforms[i], emitter.color);
+    f32 rotation = 0.0f;
+    if(emitter.is_aligned_to_velocity) {
+      rotation = (f32)freya::atan(particles.velocities_y[i], particles.velocities_x[i]);
+    }
+
+    f32 life = (particles.lifetimes[i] > 0.0f) ? (particles.ages[i] / particles.lifetimes[i]) : 1.0f;
+    instances.push_back(ParticleInstance{position, rotation, life});
+  }
+
+  if(instances.empty()) {
+    return;
   }
+
+  // Make some room for the instances if needed 
+  //
+  // @NOTE: Recreating the buffer mid-frame is fine, since the draws 
+  // that were already issued keep hold of the old one.
+
+  sg_range data = {instances.data(), instances.size() * sizeof(ParticleInstance)};
+
+  if(sg_query_buffer_will_overflow(s_renderer.particle_buffer, data.size)) {
+    create_particle_buffer(glm::max(s_renderer.particle_buffer_size * 2, data.size));
+  }
+
+  // The particles live outside of the painter's vertex stream, 
+  // so anything queued before them must be drawn first.
+  sgp_flush();
+
+  const sgp_mat2x3& mvp = sgp_query_state()->mvp;
+  Vec4 end_color        = emitter.color * emitter.color_over_life;
+  Vec2 end_scale        = emitter.initial_scale * emitter.scale_over_life;
+
+  ParticleParams_t params = {
+    .u_mvp_x       = {mvp.v[0][0], mvp.v[0][1], mvp.v[0][2], 0.0f},
+    .u_mvp_y       = {mvp.v[1][0], mvp.v[1][1], mvp.v[1][2], 0.0f},
+    .u_start_color = {emitter.color.r, emitter.color.g, emitter.color.b, emitter.color.a},
+    .u_end_color   = {end_color.r, end_color.g, end_color.b, end_color.a},
+    .u_scale       = {emitter.initial_scale.x, emitter.initial_scale.y, end_scale.x, end_scale.y},
+  };
+
+  // One upload and one draw for the whole emitter
+
+  const Texture& texture = (emitter.texture.id != -1) ? emitter.texture : s_renderer.particle_texture;
+
+  sg_bindings bindings                    = {};
+  bindings.vertex_buffers[0]              = s_renderer.particle_buffer;
+  bindings.vertex_buffer_offsets[0]       = sg_append_buffer(s_renderer.particle_buffer, data);
+  bindings.views[VIEW_particle_texture]   = texture.view;
+  bindings.samplers[SMP_particle_sampler] = texture.sampler;
+
+  sg_apply_pipeline(s_renderer.particle_pipeline);
+  sg_apply_bindings(bindings);
+  sg_apply_uniforms(UB_ParticleParams, SG_RANGE(params));
+
+  sg_draw(0, 4, (u32)instances.size());
 }
 
 void renderer_queue_text(UIText& text) {
@@ -469,6 +899,28 @@ void renderer_queue_text(UIText& text) {
     ui_text_place(text);
   }
 
+  // Texts are always in screen space, so skip any that fall outside the framebuffer
+
+  s_renderer.stats.texts_submitted++;
+
+  f32 bounds[4];
+  fonsTextBounds(s_renderer.fons, text.position.x, text.position.y, text.string.c_str(), nullptr, bounds);
+
+  Rect2D text_rect = {
+    .size     = Vec2(bounds[2] - bounds[0], bounds[3] - bounds[1]), 
+    .position = Vec2(bounds[0], bounds[1]),
+  };
+
+  Rect2D screen_rect = {
+    .size     = Vec2(window_get_framebuffer_size(s_renderer.window)),
+    .position = Vec2(0.0f),
+  };
+
+  if(!rect_in_rect(text_rect, screen_rect)) {
+    s_renderer.stats.texts_culled++;
+    return;
+  }
+
   // Draw
   fonsDrawText(s_renderer.fons, text.position.x, text.position.y, text.string.c_str(), nullptr);
 }
@@ -477,9 +929,12 @@ void renderer_prepare() {
   FREYA_DEBUG_ASSERT(s_renderer.world, "Invalid EntityWorld found in renderer");
   FREYA_PROFILE_FUNCTION();
 
+  perf_timer_start(s_renderer.prepare_timer);
+
   // Reset the renderer's state 
   
   EntityWorld* world = s_renderer.world;
+  s_renderer.stats   = {};
 
   IVec2 frame_size = window_get_framebuffer_size(s_renderer.window);
   IVec2 size       = window_get_size(s_renderer.window);
@@ -516,6 +971,9 @@ void renderer_prepare() {
     sgp_scale(camera->zoom, camera->zoom);
   }
 
+  // Figure out what the camera can see, so that anything outside of it can be culled
+  calculate_view_rect();
+
   // 
   // Prepare the frame 
   //
@@ -545,22 +1003,32 @@ void renderer_prepare() {
 
   // Sprites
   {
-    // Check if we need to sort the view first
+    // @NOTE: Sprites and transforms are kept packed together (in the same order) in 
+    // an owning group, so both arrays are walked in lockstep. This also means the 
+    // pools cannot be sorted on their own anymore. The group has to do it.
+
+    auto group = world->group<SpriteComponent, Transform>();
+
+    // Check if we need to sort the group first
 
     if(s_renderer.can_sort) {
       auto sort_fn = [&](const SpriteComponent& a, const SpriteComponent& b) {
         return a.layer < b.layer;
       };
 
-      s_renderer.world->sort<SpriteComponent>(sort_fn);
+      group.sort<SpriteComponent>(sort_fn);
     }
     
     // Render each sprite
 
-    auto view = world->view<SpriteComponent, Transform>();
-    for(auto entt : view) {
-      const Transform& transform    = view.get<Transform>(entt);
-      const SpriteComponent& sprite = view.get<SpriteComponent>(entt);
+    for(auto [entt, sprite, transform] : group.each()) {
+      // Skip any sprites outside of the view
+
+      s_renderer.stats.sprites_submitted++;
+      if(!is_in_view(transform.position, transform.scale)) {
+        s_renderer.stats.sprites_culled++;
+        continue;
+      }
 
       // Setup the dest rect
 
@@ -583,10 +1051,16 @@ void renderer_prepare() {
   
   // Animations
   {
-    auto view = world->view<AnimationComponent, Transform>();
-    for(auto entt : view) {
-      const Transform& transform     = view.get<Transform>(entt);
-      const AnimationComponent& anim = view.get<AnimationComponent>(entt);
+    // @NOTE: Transforms are already owned by the sprites group, so the animations 
+    // can only own their own pool. Still, only the animated entities are walked.
+
+    auto group = world->group<AnimationComponent>(entt::get<Transform>);
+    for(auto [entt, anim, transform] : group.each()) {
+      s_renderer.stats.sprites_submitted++;
+      if(!is_in_view(transform.position, anim.animation.frame_size * transform.scale)) {
+        s_renderer.stats.sprites_culled++;
+        continue;
+      }
 
       renderer_queue_animation(anim.animation, transform, anim.tint);
     }
@@ -599,9 +1073,19 @@ void renderer_prepare() {
       const Transform& transform = view.get<Transform>(entt);
       const Animator& anim       = view.get<Animator>(entt);
 
-      if(!anim.animations.empty()) {
-        renderer_queue_animation(anim.animations[anim.current_animation], transform, Vec4(1.0f));
+      if(anim.animations.empty()) {
+        continue;
+      }
+
+      const Animation& animation = anim.animations[anim.current_animation];
+
+      s_renderer.stats.sprites_submitted++;
+      if(!is_in_view(transform.position, animation.frame_size * transform.scale)) {
+        s_renderer.stats.sprites_culled++;
+        continue;
       }
+
+      renderer_queue_animation(animation, transform, Vec4(1.0f));
     }
   }
 
@@ -617,7 +1101,7 @@ void renderer_prepare() {
   // Physics (@TODO: Not the best place to put this??)
   {
     if(physics_world_is_debug()) {
-      physics_world_draw_debug();
+      physics_world_draw_debug(s_renderer.view_rect);
     }
   }
 
@@ -783,11 +1267,18 @@ void renderer_prepare() {
 
 
   // Clean slate
+  
   s_renderer.can_sort = false;
+  s_renderer.is_dirty = false;
+
+  perf_timer_stop(s_renderer.prepare_timer);
+  s_renderer.stats.prepare_time = s_renderer.prepare_timer.to_milliseconds;
 }
 
 void renderer_commit() {
   FREYA_PROFILE_FUNCTION();
+
+  perf_timer_start(s_renderer.commit_timer);
   
   // Reset the painter's state
   sgp_reset_blend_mode();
@@ -871,6 +1362,13 @@ void renderer_commit() {
   // Done with this frame... 
   sg_commit();
 
+  // Record the frame's statistics
+
+  perf_timer_stop(s_renderer.commit_timer);
+  s_renderer.stats.commit_time = s_renderer.commit_timer.to_milliseconds;
+  
+  stats_push_frame();
+
   // Clean the slate
   s_renderer.main_cam = nullptr;
 }
@@ -0,0 +1,339 @@
+#pragma once
+/*
+    #version:1# (machine generated, don't edit!)
+
+    Generated by sokol-shdc (https://github.com/floooh/sokol-tools)
+
+    Overview:
+    =========
+    Shader program: 'particle':
+        Get shader desc: particle_shader_desc(sg_query_backend());
+        Vertex Shader: vs
+        Fragment Shader: fs
+        Attributes:
+            ATTR_particle_a_instance => 0
+    Bindings:
+        Uniform block 'ParticleParams':
+            C struct: ParticleParams_t
+            Bind slot: UB_ParticleParams => 0
+        Texture 'particle_texture':
+            Image type: SG_IMAGETYPE_2D
+            Sample type: SG_IMAGESAMPLETYPE_FLOAT
+            Multisampled: false
+            Bind slot: VIEW_particle_texture => 0
+        Sampler 'particle_sampler':
+            Type: SG_SAMPLERTYPE_FILTERING
+            Bind slot: SMP_particle_sampler => 0
+*/
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before particle_shader.h"
+#endif
+#if !defined(SOKOL_SHDC_ALIGN)
+#if defined(_MSC_VER)
+#define SOKOL_SHDC_ALIGN(a) __declspec(align(a))
+#else
+#define SOKOL_SHDC_ALIGN(a) __attribute__((aligned(a)))
+#endif
+#endif
+#define ATTR_particle_a_instance (0)
+#define UB_ParticleParams (0)
+#define VIEW_particle_texture (0)
+#define SMP_particle_sampler (0)
+#pragma pack(push,1)
+SOKOL_SHDC_ALIGN(16) typedef struct ParticleParams_t {
+    float u_mvp_x[4];
+    float u_mvp_y[4];
+    float u_start_color[4];
+    float u_end_color[4];
+    float u_scale[4];
+} ParticleParams_t;
+#pragma pack(pop)
+/*
+    #version 430
+
+    uniform vec4 ParticleParams[5];
+    layout(location = 0) in vec4 a_instance;
+    layout(location = 0) out vec2 o_uv;
+    layout(location = 1) out vec4 o_color;
+
+    void main()
+    {
+        vec2 _corner = vec2(float(gl_VertexID & 1), float((gl_VertexID >> 1) & 1));
+        float _life = clamp(a_instance.w, 0.0, 1.0);
+        vec2 _local = (_corner - vec2(0.5)) * mix(ParticleParams[4].xy, ParticleParams[4].zw, vec2(_life));
+        float _sin = sin(a_instance.z);
+        float _cos = cos(a_instance.z);
+        vec3 _world = vec3(a_instance.x + ((_local.x * _cos) - (_local.y * _sin)), a_instance.y + ((_local.x * _sin) + (_local.y * _cos)), 1.0);
+        gl_Position = vec4(dot(ParticleParams[0].xyz, _world), dot(ParticleParams[1].xyz, _world), 0.0, 1.0);
+        o_uv = _corner;
+        o_color = mix(ParticleParams[2], ParticleParams[3], vec4(_life));
+    }
+
+*/
+static const uint8_t vs_source_glsl430[823] = {
+    0x23,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x20,0x34,0x33,0x30,0x0a,0x0a,0x75,0x6e,
+    0x69,0x66,0x6f,0x72,0x6d,0x20,0x76,0x65,0x63,0x34,0x20,0x50,0x61,0x72,0x74,0x69,
+    0x63,0x6c,0x65,0x50,0x61,0x72,0x61,0x6d,0x73,0x5b,0x35,0x5d,0x3b,0x0a,0x6c,0x61,
+    0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,
+    0x30,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x34,0x20,0x61,0x5f,0x69,0x6e,0x73,
+    0x74,0x61,0x6e,0x63,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,
+    0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x30,0x29,0x20,0x6f,0x75,0x74,0x20,
+    0x76,0x65,0x63,0x32,0x20,0x6f,0x5f,0x75,0x76,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,
+    0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x29,0x20,
+    0x6f,0x75,0x74,0x20,0x76,0x65,0x63,0x34,0x20,0x6f,0x5f,0x63,0x6f,0x6c,0x6f,0x72,
+    0x3b,0x0a,0x0a,0x76,0x6f,0x69,0x64,0x20,0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,0x7b,
+    0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x32,0x20,0x5f,0x63,0x6f,0x72,0x6e,0x65,
+    0x72,0x20,0x3d,0x20,0x76,0x65,0x63,0x32,0x28,0x66,0x6c,0x6f,0x61,0x74,0x28,0x67,
+    0x6c,0x5f,0x56,0x65,0x72,0x74,0x65,0x78,0x49,0x44,0x20,0x26,0x20,0x31,0x29,0x2c,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x28,0x28,0x67,0x6c,0x5f,0x56,0x65,0x72,0x74,0x65,
+    0x78,0x49,0x44,0x20,0x3e,0x3e,0x20,0x31,0x29,0x20,0x26,0x20,0x31,0x29,0x29,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x5f,0x6c,0x69,0x66,0x65,
+    0x20,0x3d,0x20,0x63,0x6c,0x61,0x6d,0x70,0x28,0x61,0x5f,0x69,0x6e,0x73,0x74,0x61,
+    0x6e,0x63,0x65,0x2e,0x77,0x2c,0x20,0x30,0x2e,0x30,0x2c,0x20,0x31,0x2e,0x30,0x29,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x32,0x20,0x5f,0x6c,0x6f,0x63,0x61,
+    0x6c,0x20,0x3d,0x20,0x28,0x5f,0x63,0x6f,0x72,0x6e,0x65,0x72,0x20,0x2d,0x20,0x76,
+    0x65,0x63,0x32,0x28,0x30,0x2e,0x35,0x29,0x29,0x20,0x2a,0x20,0x6d,0x69,0x78,0x28,
+    0x50,0x61,0x72,0x74,0x69,0x63,0x6c,0x65,0x50,0x61,0x72,0x61,0x6d,0x73,0x5b,0x34,
+    0x5d,0x2e,0x78,0x79,0x2c,0x20,0x50,0x61,0x72,0x74,0x69,0x63,0x6c,0x65,0x50,0x61,
+    0x72,0x61,0x6d,0x73,0x5b,0x34,0x5d,0x2e,0x7a,0x77,0x2c,0x20,0x76,0x65,0x63,0x32,
+    0x28,0x5f,0x6c,0x69,0x66,0x65,0x29,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x20,0x5f,0x73,0x69,0x6e,0x20,0x3d,0x20,0x73,0x69,0x6e,0x28,0x61,
+    0x5f,0x69,0x6e,0x73,0x74,0x61,0x6e,0x63,0x65,0x2e,0x7a,0x29,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x5f,0x63,0x6f,0x73,0x20,0x3d,0x20,0x63,
+    0x6f,0x73,0x28,0x61,0x5f,0x69,0x6e,0x73,0x74,0x61,0x6e,0x63,0x65,0x2e,0x7a,0x29,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x5f,0x77,0x6f,0x72,0x6c,
+    0x64,0x20,0x3d,0x20,0x76,0x65,0x63,0x33,0x28,0x61,0x5f,0x69,0x6e,0x73,0x74,0x61,
+    0x6e,0x63,0x65,0x2e,0x78,0x20,0x2b,0x20,0x28,0x28,0x5f,0x6c,0x6f,0x63,0x61,0x6c,
+    0x2e,0x78,0x20,0x2a,0x20,0x5f,0x63,0x6f,0x73,0x29,0x20,0x2d,0x20,0x28,0x5f,0x6c,
+    0x6f,0x63,0x61,0x6c,0x2e,0x79,0x20,0x2a,0x20,0x5f,0x73,0x69,0x6e,0x29,0x29,0x2c,
+    0x20,0x61,0x5f,0x69,0x6e,0x73,0x74,0x61,0x6e,0x63,0x65,0x2e,0x79,0x20,0x2b,0x20,
+    0x28,0x28,0x5f,0x6c,0x6f,0x63,0x61,0x6c,0x2e,0x78,0x20,0x2a,0x20,0x5f,0x73,0x69,
+    0x6e,0x29,0x20,0x2b,0x20,0x28,0x5f,0x6c,0x6f,0x63,0x61,0x6c,0x2e,0x79,0x20,0x2a,
+    0x20,0x5f,0x63,0x6f,0x73,0x29,0x29,0x2c,0x20,0x31,0x2e,0x30,0x29,0x3b,0x0a,0x20,
+    0x20,0x20,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3d,
+    0x20,0x76,0x65,0x63,0x34,0x28,0x64,0x6f,0x74,0x28,0x50,0x61,0x72,0x74,0x69,0x63,
+    0x6c,0x65,0x50,0x61,0x72,0x61,0x6d,0x73,0x5b,0x30,0x5d,0x2e,0x78,0x79,0x7a,0x2c,
+    0x20,0x5f,0x77,0x6f,0x72,0x6c,0x64,0x29,0x2c,0x20,0x64,0x6f,0x74,0x28,0x50,0x61,
+    0x72,0x74,0x69,0x63,0x6c,0x65,0x50,0x61,0x72,0x61,0x6d,0x73,0x5b,0x31,0x5d,0x2e,
+    0x78,0x79,0x7a,0x2c,0x20,0x5f,0x77,0x6f,0x72,0x6c,0x64,0x29,0x2c,0x20,0x30,0x2e,
+    0x30,0x2c,0x20,0x31,0x2e,0x30,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x6f,0x5f,0x75,
+    0x76,0x20,0x3d,0x20,0x5f,0x63,0x6f,0x72,0x6e,0x65,0x72,0x3b,0x0a,0x20,0x20,0x20,
+    0x20,0x6f,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x6d,0x69,0x78,0x28,0x50,
+    0x61,0x72,0x74,0x69,0x63,0x6c,0x65,0x50,0x61,0x72,0x61,0x6d,0x73,0x5b,0x32,0x5d,
+    0x2c,0x20,0x50,0x61,0x72,0x74,0x69,0x63,0x6c,0x65,0x50,0x61,0x72,0x61,0x6d,0x73,
+    0x5b,0x33,0x5d,0x2c,0x20,0x76,0x65,0x63,0x34,0x28,0x5f,0x6c,0x69,0x66,0x65,0x29,
+    0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x00,
+};
+/*
+    #version 430
+
+    layout(binding = 0) uniform sampler2D particle_texture_particle_sampler;
+
+    layout(location = 0) out vec4 frag_color;
+    layout(location = 0) in vec2 o_uv;
+    layout(location = 1) in vec4 o_color;
+
+    void main()
+    {
+        frag_color = texture(particle_texture_particle_sampler, o_uv) * o_color;
+    }
+
+*/
+static const uint8_t fs_source_glsl430[299] = {
+    0x23,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x20,0x34,0x33,0x30,0x0a,0x0a,0x6c,0x61,
+    0x79,0x6f,0x75,0x74,0x28,0x62,0x69,0x6e,0x64,0x69,0x6e,0x67,0x20,0x3d,0x20,0x30,
+    0x29,0x20,0x75,0x6e,0x69,0x66,0x6f,0x72,0x6d,0x20,0x73,0x61,0x6d,0x70,0x6c,0x65,
+    0x72,0x32,0x44,0x20,0x70,0x61,0x72,0x74,0x69,0x63,0x6c,0x65,0x5f,0x74,0x65,0x78,
+    0x74,0x75,0x72,0x65,0x5f,0x70,0x61,0x72,0x74,0x69,0x63,0x6c,0x65,0x5f,0x73,0x61,
+    0x6d,0x70,0x6c,0x65,0x72,0x3b,0x0a,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,
+    0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x30,0x29,0x20,0x6f,0x75,0x74,
+    0x20,0x76,0x65,0x63,0x34,0x20,0x66,0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,
+    0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,
+    0x6e,0x20,0x3d,0x20,0x30,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x32,0x20,0x6f,
+    0x5f,0x75,0x76,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,
+    0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,
+    0x34,0x20,0x6f,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x0a,0x76,0x6f,0x69,0x64,
+    0x20,0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x72,
+    0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x74,0x65,0x78,0x74,0x75,
+    0x72,0x65,0x28,0x70,0x61,0x72,0x74,0x69,0x63,0x6c,0x65,0x5f,0x74,0x65,0x78,0x74,
+    0x75,0x72,0x65,0x5f,0x70,0x61,0x72,0x74,0x69,0x63,0x6c,0x65,0x5f,0x73,0x61,0x6d,
+    0x70,0x6c,0x65,0x72,0x2c,0x20,0x6f,0x5f,0x75,0x76,0x29,0x20,0x2a,0x20,0x6f,0x5f,
+    0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x7d,0x0a,0x0a,0x00,
+};
+/*
+    #version 300 es
+
+    uniform vec4 ParticleParams[5];
+    layout(location = 0) in vec4 a_instance;
+    out vec2 o_uv;
+    out vec4 o_color;
+
+    void main()
+    {
+        vec2 _corner = vec2(float(gl_VertexID & 1), float((gl_VertexID >> 1) & 1));
+        float _life = clamp(a_instance.w, 0.0, 1.0);
+        vec2 _local = (_corner - vec2(0.5)) * mix(ParticleParams[4].xy, ParticleParams[4].zw, vec2(_life));
+        float _sin = sin(a_instance.z);
+        float _cos = cos(a_instance.z);
+        vec3 _world = vec3(a_instance.x + ((_local.x * _cos) - (_local.y * _sin)), a_instance.y + ((_local.x * _sin) + (_local.y * _cos)), 1.0);
+        gl_Position = vec4(dot(ParticleParams[0].xyz, _world), dot(ParticleParams[1].xyz, _world), 0.0, 1.0);
+        o_uv = _corner;
+        o_color = mix(ParticleParams[2], ParticleParams[3], vec4(_life));
+    }
+
+*/
+static const uint8_t vs_source_glsl300es[784] = {
+    0x23,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x20,0x33,0x30,0x30,0x20,0x65,0x73,0x0a,
+    0x0a,0x75,0x6e,0x69,0x66,0x6f,0x72,0x6d,0x20,0x76,0x65,0x63,0x34,0x20,0x50,0x61,
+    0x72,0x74,0x69,0x63,0x6c,0x65,0x50,0x61,0x72,0x61,0x6d,0x73,0x5b,0x35,0x5d,0x3b,
+    0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,
+    0x20,0x3d,0x20,0x30,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x34,0x20,0x61,0x5f,
+    0x69,0x6e,0x73,0x74,0x61,0x6e,0x63,0x65,0x3b,0x0a,0x6f,0x75,0x74,0x20,0x76,0x65,
+    0x63,0x32,0x20,0x6f,0x5f,0x75,0x76,0x3b,0x0a,0x6f,0x75,0x74,0x20,0x76,0x65,0x63,
+    0x34,0x20,0x6f,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x0a,0x76,0x6f,0x69,0x64,
+    0x20,0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,
+    0x63,0x32,0x20,0x5f,0x63,0x6f,0x72,0x6e,0x65,0x72,0x20,0x3d,0x20,0x76,0x65,0x63,
+    0x32,0x28,0x66,0x6c,0x6f,0x61,0x74,0x28,0x67,0x6c,0x5f,0x56,0x65,0x72,0x74,0x65,
+    0x78,0x49,0x44,0x20,0x26,0x20,0x31,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x28,
+    0x28,0x67,0x6c,0x5f,0x56,0x65,0x72,0x74,0x65,0x78,0x49,0x44,0x20,0x3e,0x3e,0x20,
+    0x31,0x29,0x20,0x26,0x20,0x31,0x29,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x20,0x5f,0x6c,0x69,0x66,0x65,0x20,0x3d,0x20,0x63,0x6c,0x61,0x6d,
+    0x70,0x28,0x61,0x5f,0x69,0x6e,0x73,0x74,0x61,0x6e,0x63,0x65,0x2e,0x77,0x2c,0x20,
+    0x30,0x2e,0x30,0x2c,0x20,0x31,0x2e,0x30,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,
+    0x65,0x63,0x32,0x20,0x5f,0x6c,0x6f,0x63,0x61,0x6c,0x20,0x3d,0x20,0x28,0x5f,0x63,
+    0x6f,0x72,0x6e,0x65,0x72,0x20,0x2d,0x20,0x76,0x65,0x63,0x32,0x28,0x30,0x2e,0x35,
+    0x29,0x29,0x20,0x2a,0x20,0x6d,0x69,0x78,0x28,0x50,0x61,0x72,0x74,0x69,0x63,0x6c,
+    0x65,0x50,0x61,0x72,0x61,0x6d,0x73,0x5b,0x34,0x5d,0x2e,0x78,0x79,0x2c,0x20,0x50,
+    0x61,0x72,0x74,0x69,0x63,0x6c,0x65,0x50,0x61,0x72,0x61,0x6d,0x73,0x5b,0x34,0x5d,
+    0x2e,0x7a,0x77,0x2c,0x20,0x76,0x65,0x63,0x32,0x28,0x5f,0x6c,0x69,0x66,0x65,0x29,
+    0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x5f,0x73,0x69,
+    0x6e,0x20,0x3d,0x20,0x73,0x69,0x6e,0x28,0x61,0x5f,0x69,0x6e,0x73,0x74,0x61,0x6e,
+    0x63,0x65,0x2e,0x7a,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,
+    0x20,0x5f,0x63,0x6f,0x73,0x20,0x3d,0x20,0x63,0x6f,0x73,0x28,0x61,0x5f,0x69,0x6e,
+    0x73,0x74,0x61,0x6e,0x63,0x65,0x2e,0x7a,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,
+    0x65,0x63,0x33,0x20,0x5f,0x77,0x6f,0x72,0x6c,0x64,0x20,0x3d,0x20,0x76,0x65,0x63,
+    0x33,0x28,0x61,0x5f,0x69,0x6e,0x73,0x74,0x61,0x6e,0x63,0x65,0x2e,0x78,0x20,0x2b,
+    0x20,0x28,0x28,0x5f,0x6c,0x6f,0x63,0x61,0x6c,0x2e,0x78,0x20,0x2a,0x20,0x5f,0x63,
+    0x6f,0x73,0x29,0x20,0x2d,0x20,0x28,0x5f,0x6c,0x6f,0x63,0x61,0x6c,0x2e,0x79,0x20,
+    0x2a,0x20,0x5f,0x73,0x69,0x6e,0x29,0x29,0x2c,0x20,0x61,0x5f,0x69,0x6e,0x73,0x74,
+    0x61,0x6e,0x63,0x65,0x2e,0x79,0x20,0x2b,0x20,0x28,0x28,0x5f,0x6c,0x6f,0x63,0x61,
+    0x6c,0x2e,0x78,0x20,0x2a,0x20,0x5f,0x73,0x69,0x6e,0x29,0x20,0x2b,0x20,0x28,0x5f,
+    0x6c,0x6f,0x63,0x61,0x6c,0x2e,0x79,0x20,0x2a,0x20,0x5f,0x63,0x6f,0x73,0x29,0x29,
+    0x2c,0x20,0x31,0x2e,0x30,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x67,0x6c,0x5f,0x50,
+    0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x76,0x65,0x63,0x34,0x28,0x64,
+    0x6f,0x74,0x28,0x50,0x61,0x72,0x74,0x69,0x63,0x6c,0x65,0x50,0x61,0x72,0x61,0x6d,
+    0x73,0x5b,0x30,0x5d,0x2e,0x78,0x79,0x7a,0x2c,0x20,0x5f,0x77,0x6f,0x72,0x6c,0x64,
+    0x29,0x2c,0x20,0x64,0x6f,0x74,0x28,0x50,0x61,0x72,0x74,0x69,0x63,0x6c,0x65,0x50,
+    0x61,0x72,0x61,0x6d,0x73,0x5b,0x31,0x5d,0x2e,0x78,0x79,0x7a,0x2c,0x20,0x5f,0x77,
+    0x6f,0x72,0x6c,0x64,0x29,0x2c,0x20,0x30,0x2e,0x30,0x2c,0x20,0x31,0x2e,0x30,0x29,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x6f,0x5f,0x75,0x76,0x20,0x3d,0x20,0x5f,0x63,0x6f,
+    0x72,0x6e,0x65,0x72,0x3b,0x0a,0x20,0x20,0x20,0x20,0x6f,0x5f,0x63,0x6f,0x6c,0x6f,
+    0x72,0x20,0x3d,0x20,0x6d,0x69,0x78,0x28,0x50,0x61,0x72,0x74,0x69,0x63,0x6c,0x65,
+    0x50,0x61,0x72,0x61,0x6d,0x73,0x5b,0x32,0x5d,0x2c,0x20,0x50,0x61,0x72,0x74,0x69,
+    0x63,0x6c,0x65,0x50,0x61,0x72,0x61,0x6d,0x73,0x5b,0x33,0x5d,0x2c,0x20,0x76,0x65,
+    0x63,0x34,0x28,0x5f,0x6c,0x69,0x66,0x65,0x29,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x00,
+};
+/*
+    #version 300 es
+    precision mediump float;
+    precision highp int;
+
+    uniform highp sampler2D particle_texture_particle_sampler;
+
+    layout(location = 0) out highp vec4 frag_color;
+    in highp vec2 o_uv;
+    in highp vec4 o_color;
+
+    void main()
+    {
+        frag_color = texture(particle_texture_particle_sampler, o_uv) * o_color;
+    }
+
+*/
+static const uint8_t fs_source_glsl300es[310] = {
+    0x23,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x20,0x33,0x30,0x30,0x20,0x65,0x73,0x0a,
+    0x70,0x72,0x65,0x63,0x69,0x73,0x69,0x6f,0x6e,0x20,0x6d,0x65,0x64,0x69,0x75,0x6d,
+    0x70,0x20,0x66,0x6c,0x6f,0x61,0x74,0x3b,0x0a,0x70,0x72,0x65,0x63,0x69,0x73,0x69,
+    0x6f,0x6e,0x20,0x68,0x69,0x67,0x68,0x70,0x20,0x69,0x6e,0x74,0x3b,0x0a,0x0a,0x75,
+    0x6e,0x69,0x66,0x6f,0x72,0x6d,0x20,0x68,0x69,0x67,0x68,0x70,0x20,0x73,0x61,0x6d,
+    0x70,0x6c,0x65,0x72,0x32,0x44,0x20,0x70,0x61,0x72,0x74,0x69,0x63,0x6c,0x65,0x5f,
+    0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x5f,0x70,0x61,0x72,0x74,0x69,0x63,0x6c,0x65,
+    0x5f,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x3b,0x0a,0x0a,0x6c,0x61,0x79,0x6f,0x75,
+    0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x30,0x29,0x20,
+    0x6f,0x75,0x74,0x20,0x68,0x69,0x67,0x68,0x70,0x20,0x76,0x65,0x63,0x34,0x20,0x66,
+    0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x69,0x6e,0x20,0x68,0x69,
+    0x67,0x68,0x70,0x20,0x76,0x65,0x63,0x32,0x20,0x6f,0x5f,0x75,0x76,0x3b,0x0a,0x69,
+    0x6e,0x20,0x68,0x69,0x67,0x68,0x70,0x20,0x76,0x65,0x63,0x34,0x20,0x6f,0x5f,0x63,
+    0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x0a,0x76,0x6f,0x69,0x64,0x20,0x6d,0x61,0x69,0x6e,
+    0x28,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x72,0x61,0x67,0x5f,0x63,0x6f,
+    0x6c,0x6f,0x72,0x20,0x3d,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x28,0x70,0x61,
+    0x72,0x74,0x69,0x63,0x6c,0x65,0x5f,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x5f,0x70,
+    0x61,0x72,0x74,0x69,0x63,0x6c,0x65,0x5f,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x2c,
+    0x20,0x6f,0x5f,0x75,0x76,0x29,0x20,0x2a,0x20,0x6f,0x5f,0x63,0x6f,0x6c,0x6f,0x72,
+    0x3b,0x0a,0x7d,0x0a,0x0a,0x00,
+};
+static inline const sg_shader_desc* particle_shader_desc(sg_backend backend) {
+    if (backend == SG_BACKEND_GLCORE) {
+        static sg_shader_desc desc;
+        static bool valid;
+        if (!valid) {
+            valid = true;
+            desc.vertex_func.source = (const char*)vs_source_glsl430;
+            desc.vertex_func.entry = "main";
+            desc.fragment_func.source = (const char*)fs_source_glsl430;
+            desc.fragment_func.entry = "main";
+            desc.attrs[0].base_type = SG_SHADERATTRBASETYPE_FLOAT;
+            desc.attrs[0].glsl_name = "a_instance";
+            desc.uniform_blocks[0].stage = SG_SHADERSTAGE_VERTEX;
+            desc.uniform_blocks[0].layout = SG_UNIFORMLAYOUT_STD140;
+            desc.uniform_blocks[0].size = 80;
+            desc.uniform_blocks[0].glsl_uniforms[0].type = SG_UNIFORMTYPE_FLOAT4;
+            desc.uniform_blocks[0].glsl_uniforms[0].array_count = 5;
+            desc.uniform_blocks[0].glsl_uniforms[0].glsl_name = "ParticleParams";
+            desc.views[0].texture.stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.views[0].texture.image_type = SG_IMAGETYPE_2D;
+            desc.views[0].texture.sample_type = SG_IMAGESAMPLETYPE_FLOAT;
+            desc.views[0].texture.multisampled = false;
+            desc.samplers[0].stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.samplers[0].sampler_type = SG_SAMPLERTYPE_FILTERING;
+            desc.texture_sampler_pairs[0].stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.texture_sampler_pairs[0].view_slot = 0;
+            desc.texture_sampler_pairs[0].sampler_slot = 0;
+            desc.texture_sampler_pairs[0].glsl_name = "particle_texture_particle_sampler";
+            desc.label = "particle_shader";
+        }
+        return &desc;
+    }
+    if (backend == SG_BACKEND_GLES3) {
+        static sg_shader_desc desc;
+        static bool valid;
+        if (!valid) {
+            valid = true;
+            desc.vertex_func.source = (const char*)vs_source_glsl300es;
+            desc.vertex_func.entry = "main";
+            desc.fragment_func.source = (const char*)fs_source_glsl300es;
+            desc.fragment_func.entry = "main";
+            desc.attrs[0].base_type = SG_SHADERATTRBASETYPE_FLOAT;
+            desc.attrs[0].glsl_name = "a_instance";
+            desc.uniform_blocks[0].stage = SG_SHADERSTAGE_VERTEX;
+            desc.uniform_blocks[0].layout = SG_UNIFORMLAYOUT_STD140;
+            desc.uniform_blocks[0].size = 80;
+            desc.uniform_blocks[0].glsl_uniforms[0].type = SG_UNIFORMTYPE_FLOAT4;
+            desc.uniform_blocks[0].glsl_uniforms[0].array_count = 5;
+            desc.uniform_blocks[0].glsl_uniforms[0].glsl_name = "ParticleParams";
+            desc.views[0].texture.stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.views[0].texture.image_type = SG_IMAGETYPE_2D;
+            desc.views[0].texture.sample_type = SG_IMAGESAMPLETYPE_FLOAT;
+            desc.views[0].texture.multisampled = false;
+            desc.samplers[0].stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.samplers[0].sampler_type = SG_SAMPLERTYPE_FILTERING;
+            desc.texture_sampler_pairs[0].stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.texture_sampler_pairs[0].view_slot = 0;
+            desc.texture_sampler_pairs[0].sampler_slot = 0;
+            desc.texture_sampler_pairs[0].glsl_name = "particle_texture_particle_sampler";
+            desc.label = "particle_shader";
+        }
+        return &desc;
+    }
+    return 0;
+}
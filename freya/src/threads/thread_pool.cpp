@@ -4,22 +4,42 @@
 
 namespace freya { // Start of freya
 
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static inline void finish_task(ThreadPool* pool) {
+  pool->pending_tasks.fetch_sub(1, std::memory_order_acq_rel);
+
+  // Wake up anyone stuck in `thread_pool_wait`
+  pool->pending_tasks.notify_all();
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// Callbacks
 
 static void worker_callback(ThreadPool* pool, const sizei worker_index) {
   while(true) {
-    if(!pool->is_active) { // Not working anymore! Go back home...
+    // Nothing to do. Sleep until a task gets pushed (or until we are sent home)
+    pool->tasks_signal.acquire();
+
+    if(!pool->is_active.load(std::memory_order_acquire)) { // Not working anymore! Go back home...
       break;
     }
 
     // Dequeue a task from the queue
+    //
+    // @NOTE: This can come up empty if `thread_pool_wait` got to the task 
+    // first. That's fine. We just go back to sleep.
 
     ThreadTaskFn func;
     bool found_task = pool->tasks.try_dequeue(func);
 
     if(found_task) { // Found one! Have at it...
       func();
+      finish_task(pool);
     }
   }
 
@@ -33,8 +53,10 @@ static void worker_callback(ThreadPool* pool, const sizei worker_index) {
 /// ThreadPool functions
 
 void thread_pool_create(ThreadPool& pool, const String& name, const sizei worker_count) {
-  pool.name      = name; 
-  pool.is_active = true;
+  pool.name = name; 
+  pool.is_active.store(true, std::memory_order_release);
+
+  pool.pending_tasks = 0;
 
   pool.workers.reserve(worker_count);
   for(sizei i = 0; i < worker_count; i++) {
@@ -44,20 +66,53 @@ void thread_pool_create(ThreadPool& pool, const String& name, const sizei worker
 
 void thread_pool_destroy(ThreadPool& pool) {
   // Make sure that all of the tasks are done
-  while(pool.tasks.size_approx() > 0);
+  thread_pool_wait(pool);
 
   // Make sure that all the worker threads are 
   // done so that we can get rid of them.
 
-  pool.is_active = false;
+  pool.is_active.store(false, std::memory_order_release);
+  pool.tasks_signal.release((std::ptrdiff_t)pool.workers.size());
+
   for(auto& worker : pool.workers) {
     worker->join(); 
     delete worker;
   }
+  
+  pool.workers.clear();
+
+  // Get rid of any leftover wake-ups (from tasks that `thread_pool_wait` took on)
+  while(pool.tasks_signal.try_acquire()) {}
 }
 
 void thread_pool_push_task(ThreadPool& pool, const ThreadTaskFn& task) {
+  pool.pending_tasks.fetch_add(1, std::memory_order_relaxed);
   pool.tasks.enqueue(task);
+
+  // Wake up one of the sleeping workers
+  pool.tasks_signal.release();
+}
+
+void thread_pool_wait(ThreadPool& pool) {
+  while(true) {
+    sizei pending = pool.pending_tasks.load(std::memory_order_acquire);
+    if(pending == 0) {
+      break;
+    }
+
+    // Help out with the remaining tasks instead of just sitting there
+
+    ThreadTaskFn func;
+    if(pool.tasks.try_dequeue(func)) {
+      func();
+      finish_task(&pool);
+
+      continue;
+    }
+
+    // The last few tasks are still being worked on. Sleep until one of them is done.
+    pool.pending_tasks.wait(pending, std::memory_order_acquire);
+  }
 }
 
 const sizei thread_pool_get_approx_size(const ThreadPool& pool) {
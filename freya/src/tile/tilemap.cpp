@@ -40,7 +40,7 @@ IVec2 tilemap_coords_to_index(TileMap& map, const Vec2& coords) {
 
 void tilemap_push_layer(TileMap& map, const String& name) {
   TileLayer& layer = map.layers.emplace_back(name);
-  layer.tiles.resize(map.tiles_count.x * map.tiles_count.y);
+  layer.tiles.resize(map.tiles_count.x * map.tiles_count.y, ENTITY_NULL);
 }
 
 void tilemap_pop_layer(TileMap& map) {
@@ -143,6 +143,24 @@ EntityID& tilemap_place_at(TileMap& map, const Vec2& position, const sizei layer
   return tilemap_place_at(map, index.x, index.y, layer);
 }
 
+void tilemap_build_collision_grid(TileMap& map, ParticleCollisionGrid& out_grid, const sizei layer) {
+  FREYA_DEBUG_ASSERT((layer >= 0 && layer < map.layers.size()), "Invalid tile layer index");
+
+  // @NOTE: The tiles are placed by their centers, so the 
+  // grid starts half a tile before the first one.
+
+  out_grid.position    = -(map.tile_size / 2.0f);
+  out_grid.cell_size   = map.tile_size;
+  out_grid.cells_count = map.tiles_count;
+
+  const TileLayer& tile_layer = map.layers[layer];
+  
+  out_grid.cells.resize(tile_layer.tiles.size());
+  for(sizei i = 0; i < tile_layer.tiles.size(); i++) {
+    out_grid.cells[i] = (tile_layer.tiles[i] != ENTITY_NULL) ? 1 : 0;
+  }
+}
+
 /// TileMap functions
 /// ----------------------------------------------------------------------
 
@@ -84,6 +84,58 @@ static bool on_mouse_action(const Event& event, const void* dispatcher, const vo
 /// Callbacks
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Private functions
+
+static void draw_renderer_stats() {
+  // Last frame
+
+  const RendererStats& stats = renderer_get_stats();
+
+  ImGui::Text("Prepare: %0.3fms, Commit: %0.3fms", stats.prepare_time, stats.commit_time);
+  ImGui::Text("Draw calls: %u, Pipelines: %u, Bindings: %u, Uniforms: %u", 
+              stats.draw_calls, 
+              stats.pipeline_switches, 
+              stats.bindings_applied, 
+              stats.uniforms_applied);
+  
+  ImGui::Text("Painter commands: %u, Vertices: %u", stats.painter_commands, stats.painter_vertices);
+  ImGui::Text("Uploaded: %0.2fKiB", (f32)stats.uploaded_bytes / (f32)KiB(1));
+  
+  ImGui::Text("Sprites: %u (%u culled)", stats.sprites_submitted, stats.sprites_culled);
+  ImGui::Text("Particles: %u (%u culled)", stats.particles_submitted, stats.particles_culled);
+  ImGui::Text("Texts: %u (%u culled)", stats.texts_submitted, stats.texts_culled);
+  ImGui::Text("Post-process passes: %u", stats.post_process_passes);
+
+  // History
+
+  u32 offset                   = 0;
+  const RendererStats* history = renderer_get_stats_history(&offset);
+
+  ImGui::PlotLines("Prepare (ms)", 
+                   &history[0].prepare_time, 
+                   RENDERER_STATS_HISTORY_MAX, 
+                   offset, 
+                   nullptr, 
+                   0.0f, 
+                   FLT_MAX, 
+                   ImVec2(0.0f, 48.0f), 
+                   sizeof(RendererStats));
+  
+  ImGui::PlotLines("Commit (ms)", 
+                   &history[0].commit_time, 
+                   RENDERER_STATS_HISTORY_MAX, 
+                   offset, 
+                   nullptr, 
+                   0.0f, 
+                   FLT_MAX, 
+                   ImVec2(0.0f, 48.0f), 
+                   sizeof(RendererStats));
+}
+
+/// Private functions
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// GUI functions
 
@@ -196,6 +248,11 @@ void gui_renderer_info() {
     renderer_set_clear_color(clear_color);
   }
 
+  // Frame statistics
+
+  ImGui::SeparatorText("Frame stats");
+  draw_renderer_stats();
+
   gui_end_panel();
 }
 
@@ -310,6 +367,9 @@ void gui_debug_info() {
       if(is_picked) {
         renderer_set_clear_color(clear_color);
       }
+
+      // Frame statistics
+      draw_renderer_stats();
     }
   }
 
@@ -330,6 +390,13 @@ void gui_debug_info() {
         physics_world_set_fixed_timestep(timestep);
       }
 
+      // Step rate
+
+      f32 step_rate = physics_world_get_step_rate();
+      if(ImGui::SliderFloat("Step rate", &step_rate, 10.0f, 240.0f, "%.0fHz")) {
+        physics_world_set_step_rate(step_rate);
+      }
+
       // Paused
 
       bool paused = physics_world_is_paused();
@@ -596,13 +663,20 @@ void gui_edit_particle_emitter(const char* name, ParticleEmitter* emitter) {
   ImGui::DragFloat2("Velocity", &emitter->initial_velocity[0], s_gui.big_step);
   ImGui::DragFloat2("Bounds", &emitter->bounds[0], s_gui.big_step);
   
-  ImGui::DragFloat("Lifetime", &emitter->lifetime.limit, s_gui.big_step, 0.0f, 512.0f);
+  ImGui::DragFloat("Lifetime", &emitter->lifetime, s_gui.big_step, 0.0f, 512.0f);
+  ImGui::DragFloat("Lifetime variance", &emitter->lifetime_variance, s_gui.small_step, 0.0f, 512.0f);
+  ImGui::DragFloat("Spawn rate", &emitter->spawn_rate, s_gui.big_step, 0.0f, 100000.0f);
   ImGui::DragFloat("Gravity", &emitter->gravity_factor, s_gui.big_step);
  
   // Rendering
   
   ImGui::DragFloat2("Scale", &emitter->initial_scale[0], s_gui.big_step);
+  ImGui::DragFloat2("Scale over life", &emitter->scale_over_life[0], s_gui.small_step, 0.0f, 64.0f);
+  
   ImGui::ColorEdit4("Color", &emitter->color[0]);
+  ImGui::ColorEdit4("Color over life", &emitter->color_over_life[0]);
+
+  ImGui::Checkbox("Align to velocity", &emitter->is_aligned_to_velocity);
 
   //
   // Distribution
@@ -615,8 +689,20 @@ void gui_edit_particle_emitter(const char* name, ParticleEmitter* emitter) {
     emitter->distribution = (ParticleDistributionType)current_dist;
   }
 
+  //
+  // Collision
+  //
+
+  i32 current_collision = emitter->collision;
+  if(ImGui::Combo("Collision", &current_collision, "None\0Physics\0Grid\0\0")) {
+    emitter->collision = (ParticleCollisionType)current_collision;
+  }
+
+  ImGui::SliderFloat("Bounce", &emitter->bounce, 0.0f, 1.0f);
+  ImGui::SliderFloat("Friction", &emitter->friction, 0.0f, 1.0f);
+
   // Particles count
-  ImGui::SliderInt("Count", &emitter->particles_count, 1, (i32)(PARTICLES_MAX - 1));
+  ImGui::Text("Particles: %i / %i", emitter->particles_count, emitter->particles_capacity);
   
   ImGui::PopID(); 
 }
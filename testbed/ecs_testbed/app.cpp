@@ -0,0 +1,194 @@
+#include "app.h"
+
+#include <freya.h>
+#include <imgui.h>
+
+/// ----------------------------------------------------------------------
+/// Consts
+
+const freya::sizei BENCH_ITERATIONS = 100;
+const freya::sizei BENCH_SIZES[]    = {10'000, 100'000};
+
+/// Consts
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// BenchResult
+struct BenchResult {
+  freya::sizei entities_count = 0;
+
+  freya::f32 view_ms  = 0.0f;
+  freya::f32 group_ms = 0.0f;
+};
+/// BenchResult
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// App
+struct App {
+  freya::Window* window;
+
+  freya::DynamicArray<BenchResult> results;
+
+  // @NOTE: Written to by every benchmark, so the loops
+  // cannot be optimized away by the compiler.
+  volatile freya::f32 sink = 0.0f;
+};
+
+static App s_app;
+/// App
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static void populate_world(freya::EntityWorld& world, const freya::sizei sprites_count) {
+  freya::Rng rng;
+  freya::rng_seed(rng, 1234);
+
+  // Twice as many transforms as sprites, with the sprites added in a random order,
+  // so the two pools end up in different orders (just like any real scene would).
+
+  freya::DynamicArray<freya::EntityID> entities;
+  freya::entity_create_many(world, entities, sprites_count * 2);
+
+  for(auto& entt : entities) {
+    world.get<freya::Transform>(entt).position = freya::Vec2(freya::random_f32(rng, -1000.0f, 1000.0f),
+                                                             freya::random_f32(rng, -1000.0f, 1000.0f));
+  }
+
+  for(freya::sizei i = entities.size() - 1; i > 0; i--) {
+    freya::sizei j = (freya::sizei)freya::random_u64(rng, 0, i);
+    std::swap(entities[i], entities[j]);
+  }
+
+  for(freya::sizei i = 0; i < sprites_count; i++) {
+    freya::SpriteComponent sprite = {};
+    sprite.color                  = freya::Vec4(freya::random_f32(rng));
+
+    world.emplace<freya::SpriteComponent>(entities[i], sprite);
+  }
+}
+
+template<typename Iterable>
+static freya::f32 run_bench(Iterable& iterable) {
+  freya::PerfTimer timer;
+  freya::perf_timer_start(timer);
+
+  freya::f32 sum = 0.0f;
+  for(freya::sizei i = 0; i < BENCH_ITERATIONS; i++) {
+    for(auto [entt, sprite, transform] : iterable.each()) {
+      sum += (transform.position.x * sprite.color.r) + transform.position.y;
+    }
+  }
+
+  freya::perf_timer_stop(timer);
+  s_app.sink = s_app.sink + sum;
+
+  return timer.to_milliseconds / BENCH_ITERATIONS;
+}
+
+static void run_benchmarks() {
+  s_app.results.clear();
+
+  for(auto& count : BENCH_SIZES) {
+    BenchResult result = {.entities_count = count};
+
+    // Views (the sprites pool leads, looking up each transform)
+    {
+      freya::EntityWorld world;
+      populate_world(world, count);
+
+      auto view      = world.view<freya::SpriteComponent, freya::Transform>();
+      result.view_ms = run_bench(view);
+
+      freya::entity_world_clear(world);
+    }
+
+    // Owning groups (both pools walked in lockstep)
+    {
+      freya::EntityWorld world;
+      populate_world(world, count);
+
+      auto group      = world.group<freya::SpriteComponent, freya::Transform>();
+      result.group_ms = run_bench(group);
+
+      freya::entity_world_clear(world);
+    }
+
+    FREYA_LOG_INFO("%zu sprites: view = %fms, group = %fms (x%.2f)",
+                   count,
+                   result.view_ms,
+                   result.group_ms,
+                   result.view_ms / result.group_ms);
+
+    s_app.results.push_back(result);
+  }
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// App functions
+
+bool app_init(const freya::Args& args, freya::Window* window) {
+  // App init
+  freya::renderer_set_clear_color(freya::Vec4(0.1f, 0.1f, 0.1f, 1.0f));
+
+  // Window init
+  s_app.window = window;
+
+  // Editor init
+  freya::gui_init(window);
+
+  // Benchmarks init
+  run_benchmarks();
+
+  // Done!
+  return true;
+}
+
+void app_shutdown() {
+  freya::gui_shutdown();
+}
+
+void app_update(freya::f32 dt) {
+  // Quit the application when the specified exit key is pressed
+
+  if(freya::input_key_pressed(freya::KEY_ESCAPE)) {
+    freya::event_dispatch(freya::Event{.type = freya::EVENT_APP_QUIT});
+    return;
+  }
+}
+
+void app_render_gui() {
+  freya::gui_begin();
+
+  // Debug
+  freya::gui_debug_info();
+
+  // Benchmarks
+
+  freya::gui_begin_panel("Benchmarks");
+
+  ImGui::Text("Iterating SpriteComponent + Transform (%zu times)", BENCH_ITERATIONS);
+  ImGui::Separator();
+
+  for(auto& result : s_app.results) {
+    ImGui::Text("%zu sprites", result.entities_count);
+    ImGui::BulletText("View:  %.4fms", result.view_ms);
+    ImGui::BulletText("Group: %.4fms (x%.2f)", result.group_ms, result.view_ms / result.group_ms);
+  }
+
+  if(ImGui::Button("Run again")) {
+    run_benchmarks();
+  }
+
+  freya::gui_end_panel();
+
+  freya::gui_end();
+}
+
+/// App functions
+/// ----------------------------------------------------------------------